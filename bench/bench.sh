@@ -0,0 +1,48 @@
+#!/bin/bash
+
+# Uso: ./bench/bench.sh [livros] [leitores] [comandos] [pesos] [semente]
+# Gera (uma vez por configuração) uma carga sintética em bench/data e roda o booked nela.
+
+PROJ_NAME="booked"
+
+BOOKS=${1:-5000}
+READERS=${2:-500}
+COMMANDS=${3:-20000}
+MIX=${4:-30,25,20,10,8,5,1,0}
+SEED=${5:-42}
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+DATA="$ROOT/bench/data/${BOOKS}_${READERS}_${COMMANDS}_${MIX//,/-}_${SEED}"
+
+gcc -O2 -Wall -o "$ROOT/bench/generator" "$ROOT/bench/generator.c" -lm || exit 1
+
+if [ ! -f "$DATA/comandos.txt" ]; then
+    echo "Gerando carga em $DATA"
+    mkdir -p "$DATA"
+    "$ROOT/bench/generator" -o "$DATA" -b "$BOOKS" -r "$READERS" -c "$COMMANDS" -m "$MIX" -s "$SEED" || exit 1
+fi
+
+echo "Livros: $BOOKS  Leitores: $READERS  Comandos: $COMMANDS  Pesos: $MIX"
+echo "--------------"
+
+cd "$DATA" || exit 1
+rm -f metrics.txt perf.csv trace.json
+TIMEFORMAT=%R
+{ time BOOKED_METRICS=metrics.txt BOOKED_PERF=perf.csv BOOKED_TRACE=trace.json BOOKED_TRACE_SAMPLE=10 "$ROOT/$PROJ_NAME" > /dev/null; } 2> time.txt || exit 1
+
+awk '
+/^phase/ { printf "%-16s %10.3f s\n", $2, $4 }
+/^op/    { if (!header++) printf "\n%-4s %10s %8s %12s %14s %10s %10s %10s\n",
+                                 "op", "chamadas", "erros", "segundos", "ops/s", "p50 us", "p99 us", "max us";
+           for (i = 3; i < NF; i += 2) f[$i] = $(i + 1);
+           printf "%-4s %10s %8s %12.3f %14.1f %10.1f %10.1f %10.1f\n",
+                  $2, f["calls"], f["errors"], f["seconds"], f["ops_per_second"],
+                  f["p50_ns"] / 1000, f["p99_ns"] / 1000, f["max_ns"] / 1000 }
+/^memory/ { if (!memory++) printf "\n%-16s %12s %12s %12s\n", "memoria", "pico KiB", "alocacoes", "liberacoes";
+            printf "%-16s %12.1f %12s %12s\n", $2, $6 / 1024, $8, $10 }
+' metrics.txt
+
+echo ""
+echo "Tempo total: $(tail -n 1 time.txt) s"
+echo "Contadores de hardware por fase/comando: $DATA/perf.csv"
+echo "Trace (chrome://tracing, 1 a cada 10 comandos): $DATA/trace.json"
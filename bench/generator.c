@@ -0,0 +1,421 @@
+/**
+ * @file generator.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Synthetic workload generator: writes livros.txt, leitores.txt and comandos.txt.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Uso:
+ * @code
+ * generator -o <pasta> [-b livros] [-r leitores] [-c comandos]
+ *           [-g generos] [-z skew] [-m pesos] [-s semente]
+ * @endcode
+ *
+ * - Popularidade de livros, leitores e gêneros segue uma Zipf com expoente @c -z.
+ * - @c -m recebe os pesos de cada código de operação, separados por vírgula,
+ *   começando pelo comando 1 (ex.: "30,25,20,10,8,5,1,0").
+ * - Aceites/rejeições (4 e 5) são tirados das recomendações já emitidas,
+ *   para que a maioria encontre uma recomendação pendente.
+ * - Cada código de 1 a 23 tem o seu formato (quantidades, intervalos de
+ *   anos, texto); o código 9 não existe e só aceita peso 0.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <unistd.h>
+
+#define MAX_OPS 23 // último código de operação que o gerador sabe formatar
+#define MIN_YEAR 1800
+#define MAX_YEAR 2025
+#define PENDING_RING 4096
+#define MAX_PREFERENCES 3
+
+static const char *genres[] = {
+    "Romance", "Terror", "Mistério", "Fantasia", "Ficção Científica", "História",
+    "Biografia", "Poesia", "Aventura", "Drama", "Suspense", "Infantil",
+    "Filosofia", "Autoajuda", "Clássico", "Distopia", "Humor", "Policial",
+    "Religião", "Ciência", "Arte", "Viagem", "Culinária", "Negócios"};
+
+static const char *words[] = {
+    "O", "A", "Sombra", "Noite", "Casa", "Rio", "Tempo", "Mar", "Luz", "Cidade",
+    "Segredo", "Jardim", "Vento", "Memória", "Guerra", "Amor", "Estrela", "Caminho",
+    "Silêncio", "Fogo", "Reino", "Ilha", "Espelho", "Lua", "Pedra", "Sol", "Voz",
+    "Sangue", "Céu", "Porta", "Inverno", "Verão", "Livro", "Sonho", "Herança",
+    "Labirinto", "Nome", "Rosa", "Velho", "Menino", "Última", "Primeira", "Viagem"};
+
+static const char *firstNames[] = {
+    "Ana", "Bruno", "Carla", "Diego", "Elisa", "Fábio", "Gabriela", "Heitor",
+    "Isabela", "João", "Karina", "Lucas", "Marina", "Nuno", "Olívia", "Pedro",
+    "Quésia", "Rafael", "Sofia", "Tiago", "Úrsula", "Vitor", "Wagner", "Yara"};
+
+static const char *lastNames[] = {
+    "Silva", "Souza", "Costa", "Santos", "Oliveira", "Pereira", "Rodrigues",
+    "Almeida", "Nascimento", "Lima", "Araújo", "Fernandes", "Carvalho", "Gomes",
+    "Martins", "Rocha", "Ribeiro", "Alves", "Monteiro", "Mendes", "Barros"};
+
+#define LEN(array) ((int)(sizeof(array) / sizeof((array)[0])))
+
+typedef struct
+{
+    int n;
+    double *cdf;
+} Zipf;
+
+typedef struct
+{
+    int recipient;
+    int book;
+    int recommender;
+} Pending;
+
+static double Uniform(void)
+{
+    return (random() + 0.5) / ((double)RAND_MAX + 1.0);
+}
+
+static int Between(int lo, int hi)
+{
+    return lo + (int)(Uniform() * (hi - lo + 1));
+}
+
+static Zipf CreateZipf(int n, double skew)
+{
+    Zipf zipf = {n, malloc(n * sizeof(double))};
+    assert(zipf.cdf);
+    double sum = 0;
+
+    for (int i = 0; i < n; i++)
+        zipf.cdf[i] = (sum += 1.0 / pow(i + 1, skew));
+
+    for (int i = 0; i < n; i++)
+        zipf.cdf[i] /= sum;
+
+    return zipf;
+}
+
+/**
+ * @brief Sorteia um valor em [0, n) com probabilidade proporcional a 1/(k+1)^skew.
+ */
+static int SampleZipf(Zipf *zipf)
+{
+    double u = Uniform();
+    int lo = 0, hi = zipf->n - 1;
+
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+
+        if (zipf->cdf[mid] < u)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Espalha a popularidade pelos IDs, para o mais popular não ser sempre o ID 1.
+ */
+static int ScatterId(int rank, int n)
+{
+    return (int)(((long)rank * 7919 + 13) % n) + 1;
+}
+
+static FILE *OpenOutput(const char *dir, const char *name)
+{
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *file = fopen(path, "w");
+
+    if (!file)
+    {
+        perror(path);
+        exit(1);
+    }
+
+    return file;
+}
+
+static void WriteBooks(const char *dir, int books, Zipf *genreZipf)
+{
+    FILE *file = OpenOutput(dir, "livros.txt");
+    fprintf(file, "id;titulo;autor;genero;ano\n");
+
+    for (int id = 1; id <= books; id++)
+    {
+        fprintf(file, "%d;", id);
+        int titleWords = Between(2, 4);
+
+        for (int w = 0; w < titleWords; w++)
+            fprintf(file, "%s%s", w ? " " : "", words[Between(0, LEN(words) - 1)]);
+
+        fprintf(file, " %d;%s %s;%s;%d\n",
+                id,
+                firstNames[Between(0, LEN(firstNames) - 1)],
+                lastNames[Between(0, LEN(lastNames) - 1)],
+                genres[SampleZipf(genreZipf)],
+                Between(MIN_YEAR, MAX_YEAR));
+    }
+
+    fclose(file);
+}
+
+static void WriteReaders(const char *dir, int readers, Zipf *genreZipf)
+{
+    FILE *file = OpenOutput(dir, "leitores.txt");
+    fprintf(file, "Id;nome;n_afinidades;afinidades\n");
+
+    for (int id = 1; id <= readers; id++)
+    {
+        int chosen[MAX_PREFERENCES];
+        int count = Between(1, MAX_PREFERENCES);
+
+        for (int i = 0; i < count; i++)
+        {
+            chosen[i] = SampleZipf(genreZipf);
+
+            for (int j = 0; j < i; j++)
+            {
+                if (chosen[j] == chosen[i])
+                {
+                    i--, count--; // repetido: sorteia de novo com uma preferência a menos
+                    break;
+                }
+            }
+        }
+
+        fprintf(file, "%d;%s %s %d;%d",
+                id,
+                firstNames[Between(0, LEN(firstNames) - 1)],
+                lastNames[Between(0, LEN(lastNames) - 1)],
+                id, count);
+
+        for (int i = 0; i < count; i++)
+            fprintf(file, ";%s", genres[chosen[i]]);
+
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+}
+
+static int SampleOp(double *weights, int opCount, double total)
+{
+    double u = Uniform() * total;
+
+    for (int op = 0; op < opCount; op++)
+    {
+        if ((u -= weights[op]) < 0)
+            return op + 1;
+    }
+
+    return opCount;
+}
+
+static void WriteCommands(const char *dir, long commands, int books, int readers,
+                          int genreCount, double *weights, int opCount, double skew)
+{
+    FILE *file = OpenOutput(dir, "comandos.txt");
+    fprintf(file, "funcionalidade;id1;id2;id3\n");
+
+    Zipf bookZipf = CreateZipf(books, skew);
+    Zipf readerZipf = CreateZipf(readers, skew);
+    Pending pending[PENDING_RING];
+    int pendingCount = 0;
+    double total = 0;
+
+    for (int op = 0; op < opCount; op++)
+        total += weights[op];
+
+    for (long i = 0; i < commands; i++)
+    {
+        int op = SampleOp(weights, opCount, total);
+        int user1 = ScatterId(SampleZipf(&readerZipf), readers);
+        int user2 = ScatterId(SampleZipf(&readerZipf), readers);
+        int book = ScatterId(SampleZipf(&bookZipf), books);
+
+        if (readers > 1)
+        {
+            while (user2 == user1)
+                user2 = Between(1, readers);
+        }
+
+        switch (op)
+        {
+        case 3:
+            if (pendingCount < PENDING_RING)
+                pending[pendingCount++] = (Pending){user2, book, user1};
+            else
+                pending[Between(0, PENDING_RING - 1)] = (Pending){user2, book, user1};
+
+            fprintf(file, "3;%d;%d;%d\n", user1, book, user2);
+            break;
+
+        case 4:
+        case 5:
+            if (pendingCount && Uniform() < 0.9)
+            {
+                int k = Between(0, pendingCount - 1);
+                Pending p = pending[k];
+                pending[k] = pending[--pendingCount];
+                fprintf(file, "%d;%d;%d;%d\n", op, p.recipient, p.book, p.recommender);
+            }
+            else
+                fprintf(file, "%d;%d;%d;%d\n", op, user1, book, user2);
+            break;
+
+        case 6:
+        case 7:
+            fprintf(file, "%d;%d;0;%d\n", op, user1, user2);
+            break;
+
+        case 8:
+            fprintf(file, "8;0;0;0\n");
+            break;
+
+        case 10:
+        case 12:
+            fprintf(file, "%d;%d;%d;0\n", op, user1, Between(1, 10));
+            break;
+
+        case 11:
+            fprintf(file, "11;%d;0;%d\n", user1, user2);
+            break;
+
+        case 15:
+        case 16:
+            // Metade das consultas por gênero, metade no catálogo todo.
+            if (Uniform() < 0.5)
+                fprintf(file, "%d;%d;0;0;%s\n", op, Between(1, 10), genres[Between(0, genreCount - 1)]);
+            else
+                fprintf(file, "%d;%d;0;0\n", op, Between(1, 10));
+            break;
+
+        case 18:
+            fprintf(file, "18;0;0;0\n");
+            break;
+
+        case 19:
+            fprintf(file, "19;%d;%d;%d\n", user1, Between(1, 10), Between(0, 1));
+            break;
+
+        case 20:
+            fprintf(file, "20;%d;0;0;%s\n", Between(1, 10), words[Between(0, LEN(words) - 1)]);
+            break;
+
+        case 21:
+            fprintf(file, "21;%d;0;0;%s %s\n", Between(1, 10),
+                    words[Between(0, LEN(words) - 1)], words[Between(0, LEN(words) - 1)]);
+            break;
+
+        case 22:
+        case 23:
+        {
+            int from = Between(MIN_YEAR, MAX_YEAR);
+            int to = Between(from, MAX_YEAR);
+
+            if (op == 22)
+                fprintf(file, "22;%d;%d;%d\n", user1, from, to);
+            else
+                fprintf(file, "23;%d;%d;%d\n", from, to, Between(1, 10));
+            break;
+        }
+
+        default: // 1, 2, 13, 14 e 17: leitor e livro, ou só o livro
+            if (op == 13 || op == 14 || op == 17)
+                fprintf(file, "%d;0;%d;0\n", op, book);
+            else
+                fprintf(file, "%d;%d;%d;0\n", op, user1, book);
+        }
+    }
+
+    free(bookZipf.cdf);
+    free(readerZipf.cdf);
+    fclose(file);
+}
+
+/**
+ * @brief Lê os pesos por código de operação.
+ *
+ * @return Quantidade de pesos lidos, ou -1 se houver mais de MAX_OPS ou
+ *         peso positivo para o código 9, que não existe.
+ */
+static int ParseMix(char *mix, double *weights)
+{
+    int count = 0;
+
+    for (char *token = strtok(mix, ","); token; token = strtok(NULL, ","))
+    {
+        if (count == MAX_OPS)
+            return -1;
+
+        weights[count++] = atof(token);
+    }
+
+    return count >= 9 && weights[8] > 0 ? -1 : count;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *dir = NULL;
+    int books = 5000;
+    int readers = 500;
+    long commands = 20000;
+    int genreCount = LEN(genres);
+    double skew = 1.0;
+    unsigned seed = 42;
+    char defaultMix[] = "30,25,20,10,8,5,1,0";
+    char *mix = defaultMix;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:b:r:c:g:z:m:s:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'o': dir = optarg; break;
+        case 'b': books = atoi(optarg); break;
+        case 'r': readers = atoi(optarg); break;
+        case 'c': commands = atol(optarg); break;
+        case 'g': genreCount = atoi(optarg); break;
+        case 'z': skew = atof(optarg); break;
+        case 'm': mix = optarg; break;
+        case 's': seed = (unsigned)atoi(optarg); break;
+        default:
+            fprintf(stderr, "uso: %s -o pasta [-b livros] [-r leitores] [-c comandos] "
+                            "[-g generos] [-z skew] [-m pesos] [-s semente]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    if (!dir || books < 1 || readers < 1 || commands < 0 || genreCount < 1 || genreCount > LEN(genres))
+    {
+        fprintf(stderr, "parâmetros inválidos (gêneros: 1 a %d)\n", LEN(genres));
+        return 1;
+    }
+
+    double weights[MAX_OPS];
+    int opCount = ParseMix(mix, weights);
+
+    if (opCount < 1)
+    {
+        fprintf(stderr, "pesos inválidos: até %d códigos, e o código 9 deve ter peso 0\n", MAX_OPS);
+        return 1;
+    }
+
+    srandom(seed);
+
+    Zipf genreZipf = CreateZipf(genreCount, skew);
+    WriteBooks(dir, books, &genreZipf);
+    WriteReaders(dir, readers, &genreZipf);
+    WriteCommands(dir, commands, books, readers, genreCount, weights, opCount, skew);
+    free(genreZipf.cdf);
+
+    return 0;
+}
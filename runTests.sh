@@ -2,7 +2,7 @@
 
 PROJ_NAME="booked"
 
-TEST_CASES=$(ls ./tests)
+TEST_CASES=$(ls ./tests | grep "^test") # as demais pastas são dos testes de "make check"
 
 GREEN="\033[0;32m"
 RED="\033[0;31m"
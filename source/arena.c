@@ -0,0 +1,117 @@
+/**
+ * @file arena.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the mmap-backed bump arena.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <sys/mman.h>
+#include "arena.h"
+
+#define ALIGN_UP(value, alignment) (((value) + (alignment) - 1) / (alignment) * (alignment))
+
+typedef struct chunk Chunk;
+
+struct chunk
+{
+    Chunk *next; // bloco mapeado antes deste
+    size_t size; // bytes mapeados, incluindo este cabeçalho
+};
+
+struct arena
+{
+    size_t chunkSize;
+    Chunk *chunks; // bloco atual primeiro
+    char *cursor;  // próximo byte livre no bloco atual
+    char *end;     // fim do bloco atual
+};
+
+#define CHUNK_HEADER ALIGN_UP(sizeof(Chunk), ARENA_ALIGNMENT)
+
+Arena *CreateArena(size_t chunkSize)
+{
+    assert(chunkSize > CHUNK_HEADER);
+    Arena *arena = malloc(sizeof(Arena));
+    assert(arena);
+    arena->chunkSize = chunkSize;
+    arena->chunks = NULL;
+    arena->cursor = arena->end = NULL;
+
+    return arena;
+}
+
+static void MapChunk(Arena *arena, size_t size)
+{
+    size_t total = size + CHUNK_HEADER > arena->chunkSize ? size + CHUNK_HEADER : arena->chunkSize;
+    Chunk *chunk = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(chunk != MAP_FAILED);
+    chunk->next = arena->chunks;
+    chunk->size = total;
+    arena->chunks = chunk;
+    arena->cursor = (char *)chunk + CHUNK_HEADER;
+    arena->end = (char *)chunk + total;
+}
+
+void *AllocArena(Arena *arena, size_t size)
+{
+    assert(arena);
+    size = ALIGN_UP(size ? size : 1, ARENA_ALIGNMENT);
+
+    if ((size_t)(arena->end - arena->cursor) < size)
+        MapChunk(arena, size);
+
+    void *ptr = arena->cursor;
+    arena->cursor += size;
+
+    return ptr;
+}
+
+static void UnmapChunks(Chunk *chunk)
+{
+    while (chunk)
+    {
+        Chunk *next = chunk->next;
+        munmap(chunk, chunk->size);
+        chunk = next;
+    }
+}
+
+void ResetArena(Arena *arena)
+{
+    assert(arena);
+
+    if (!arena->chunks)
+        return;
+
+    // O bloco mais antigo fica; os demais voltam ao sistema.
+    Chunk *oldest = arena->chunks;
+
+    while (oldest->next)
+        oldest = oldest->next;
+
+    Chunk *rest = arena->chunks;
+
+    while (rest != oldest)
+    {
+        Chunk *next = rest->next;
+        munmap(rest, rest->size);
+        rest = next;
+    }
+
+    arena->chunks = oldest;
+    arena->cursor = (char *)oldest + CHUNK_HEADER;
+    arena->end = (char *)oldest + oldest->size;
+}
+
+void FreeArena(Arena *arena)
+{
+    assert(arena);
+    UnmapChunks(arena->chunks);
+    free(arena);
+}
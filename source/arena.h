@@ -0,0 +1,62 @@
+/**
+ * @file arena.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the mmap-backed bump arena.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * @brief Alinhamento de todo objeto devolvido pela arena, em bytes.
+ */
+#define ARENA_ALIGNMENT 16
+
+/**
+ * @brief Tipo opaco que representa uma arena.
+ *
+ * A arena reserva blocos grandes com mmap e entrega objetos avançando um
+ * ponteiro dentro do bloco atual. Objetos não são liberados um a um: a
+ * arena inteira é rebobinada (ResetArena) ou devolvida ao sistema com um
+ * munmap por bloco (FreeArena).
+ */
+typedef struct arena Arena;
+
+/**
+ * @brief Cria uma arena vazia.
+ *
+ * @param chunkSize Tamanho de cada bloco mapeado; pedidos maiores ganham bloco próprio.
+ * @return Ponteiro para a nova Arena.
+ */
+Arena *CreateArena(size_t chunkSize);
+
+/**
+ * @brief Reserva @p size bytes alinhados a ARENA_ALIGNMENT (conteúdo indefinido).
+ *
+ * @param arena Ponteiro para a Arena.
+ * @param size  Quantidade de bytes.
+ * @return Ponteiro para a área reservada.
+ */
+void *AllocArena(Arena *arena, size_t size);
+
+/**
+ * @brief Rebobina a arena: tudo o que foi reservado deixa de valer.
+ *
+ * Mantém o primeiro bloco mapeado para o próximo uso e devolve os demais.
+ *
+ * @param arena Ponteiro para a Arena.
+ */
+void ResetArena(Arena *arena);
+
+/**
+ * @brief Devolve todos os blocos ao sistema e libera a arena.
+ *
+ * @param arena Ponteiro para a Arena.
+ */
+void FreeArena(Arena *arena);
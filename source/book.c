@@ -1,7 +1,7 @@
 /**
  * @file book.c
  * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
- * @brief Implementation file of functions that handles the book struct.
+ * @brief Implementation file of functions that handle the columnar book catalog.
  * @version 0.1
  * @date 2025-05-31
  *
@@ -12,40 +12,393 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <assert.h>
 #include <string.h>
+#include <limits.h>
+#include <ctype.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "book.h"
 #include "utils.h"
+#include "memory.h"
 
-struct book
+/**
+ * @brief Linhas reservadas na primeira carga; depois a capacidade dobra.
+ */
+#define CATALOG_INITIAL_ROWS 64
+
+/**
+ * @brief Bytes reservados no heap de strings na primeira carga.
+ */
+#define CATALOG_INITIAL_HEAP 4096
+
+/**
+ * @brief Marca, na coluna de títulos, uma linha ainda não decodificada do arquivo mapeado.
+ */
+#define NOT_DECODED UINT_MAX
+
+typedef struct
+{
+    int count;
+    int capacity;
+    int *ids;
+    int *years;
+    int *genres;      // ID internado do gênero
+    unsigned *titles; // deslocamento no heap de strings
+    unsigned *authors;
+
+    int *slots; // tabela aberta ID -> posição + 1 (0 = vaga livre), metade vazia no máximo
+    int slotCount;
+
+    int genreCount;
+    int genreCapacity;
+    unsigned *genreNames; // deslocamento do nome de cada gênero no heap
+
+    char *heap; // todas as strings, terminadas em '\0', uma após a outra
+    size_t heapLength;
+    size_t heapCapacity;
+
+    // Modo preguiçoso (MapBooks): só IDs e posições no arquivo são carregados.
+    char *source;      // livros.txt mapeado
+    size_t sourceLength;
+    size_t *offsets;   // início da linha de cada livro em source
+    int offsetCapacity;
+    int genresScanned; // 1 depois que FindGenreBook internou os gêneros das linhas não decodificadas
+} Catalog;
+
+static Catalog catalog = {0};
+
+static int IndexOf(void *ptr)
+{
+    assert(ptr);
+    int index = (int)((uintptr_t)ptr - 1);
+    assert(index >= 0 && index < catalog.count);
+
+    return index;
+}
+
+static Book *HandleOf(int index)
+{
+    return (Book *)(uintptr_t)(index + 1);
+}
+
+static void *GrowColumn(void *column, size_t size, int oldCapacity, int newCapacity)
+{
+    return ReallocMemory(MEMORY_BOOK, column, oldCapacity * size, newCapacity * size);
+}
+
+static void GrowRows(void)
+{
+    int capacity = catalog.capacity ? 2 * catalog.capacity : CATALOG_INITIAL_ROWS;
+    catalog.ids = GrowColumn(catalog.ids, sizeof(int), catalog.capacity, capacity);
+    catalog.years = GrowColumn(catalog.years, sizeof(int), catalog.capacity, capacity);
+    catalog.genres = GrowColumn(catalog.genres, sizeof(int), catalog.capacity, capacity);
+    catalog.titles = GrowColumn(catalog.titles, sizeof(unsigned), catalog.capacity, capacity);
+    catalog.authors = GrowColumn(catalog.authors, sizeof(unsigned), catalog.capacity, capacity);
+    catalog.capacity = capacity;
+}
+
+static unsigned HashId(int id)
+{
+    unsigned hash = (unsigned)id * 0x9E3779B1u;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+/**
+ * @brief Vaga de um ID na tabela: a que guarda a posição dele ou a livre onde entraria.
+ */
+static int *SlotId(int id)
+{
+    for (unsigned i = HashId(id) & (catalog.slotCount - 1);; i = (i + 1) & (catalog.slotCount - 1))
+    {
+        int index = catalog.slots[i] - 1;
+
+        if (index < 0 || catalog.ids[index] == id)
+            return &catalog.slots[i];
+    }
+}
+
+/**
+ * @brief Põe a última linha do catálogo na tabela de IDs, dobrando-a se passar da metade.
+ *
+ * Com IDs repetidos, fica a primeira linha, como na varredura que a tabela substitui.
+ */
+static void IndexLastRow(void)
+{
+    int *slot;
+
+    if (2 * catalog.count > catalog.slotCount)
+    {
+        int slotCount = catalog.slotCount ? 2 * catalog.slotCount : CATALOG_INITIAL_ROWS;
+        FreeMemory(MEMORY_BOOK, catalog.slots, catalog.slotCount * sizeof(int));
+        catalog.slots = CallocMemory(MEMORY_BOOK, slotCount, sizeof(int));
+        catalog.slotCount = slotCount;
+
+        for (int i = 0; i < catalog.count; i++)
+        {
+            if (!*(slot = SlotId(catalog.ids[i])))
+                *slot = i + 1;
+        }
+
+        return;
+    }
+
+    if (!*(slot = SlotId(catalog.ids[catalog.count - 1])))
+        *slot = catalog.count;
+}
+
+static unsigned PushBytes(const char *bytes, size_t length)
+{
+    size_t size = length + 1;
+
+    if (catalog.heapLength + size > catalog.heapCapacity)
+    {
+        size_t capacity = catalog.heapCapacity ? catalog.heapCapacity : CATALOG_INITIAL_HEAP;
+
+        while (catalog.heapLength + size > capacity)
+            capacity *= 2;
+
+        catalog.heap = ReallocMemory(MEMORY_BOOK, catalog.heap, catalog.heapCapacity, capacity);
+        catalog.heapCapacity = capacity;
+    }
+
+    unsigned offset = (unsigned)catalog.heapLength;
+    memcpy(catalog.heap + offset, bytes, length);
+    catalog.heap[offset + length] = '\0';
+    catalog.heapLength += size;
+
+    return offset;
+}
+
+static unsigned PushString(char *string)
+{
+    return PushBytes(string, strlen(string));
+}
+
+/**
+ * @brief Busca um gênero só entre os já internados.
+ */
+static int LookupGenre(const char *genre)
+{
+    // Poucos gêneros distintos: a varredura linear cabe em cache.
+    for (int i = 0; i < catalog.genreCount; i++)
+    {
+        if (strcmp(catalog.heap + catalog.genreNames[i], genre) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+int InternGenreBook(char *genre)
+{
+    assert(genre);
+    int id = LookupGenre(genre);
+
+    if (id >= 0)
+        return id;
+
+    if (catalog.genreCount == catalog.genreCapacity)
+    {
+        int capacity = catalog.genreCapacity ? 2 * catalog.genreCapacity : 8;
+        catalog.genreNames = GrowColumn(catalog.genreNames, sizeof(unsigned), catalog.genreCapacity, capacity);
+        catalog.genreCapacity = capacity;
+    }
+
+    catalog.genreNames[catalog.genreCount] = PushString(genre);
+
+    return catalog.genreCount++;
+}
+
+int IsLazyBooks(void)
+{
+    char *lazy = getenv(BOOK_LAZY_ENV);
+
+    return lazy && *lazy && strcmp(lazy, "0") != 0;
+}
+
+static const char *SkipField(const char *cur, const char *end)
+{
+    const char *separator = memchr(cur, ';', end - cur);
+
+    return separator ? separator : end;
+}
+
+/**
+ * @brief Interna o gênero (quarto campo, de @p genre até @p year) de uma linha do arquivo mapeado.
+ */
+static int InternFieldGenre(const char *genre, const char *year)
 {
-    int id;
-    char *title;
-    char *author;
-    char *gender;
-    int yearOfPublication;
-};
+    char genreName[MAX_LINE_LENGTH] = "";
+    size_t genreLength = year - 1 - genre;
+    assert(genreLength < sizeof(genreName));
+    memcpy(genreName, genre, genreLength);
+
+    return InternGenreBook(genreName);
+}
+
+/**
+ * @brief Fim da linha que começa em @p line no arquivo mapeado.
+ */
+static const char *LineEndOf(const char *line)
+{
+    const char *end = catalog.source + catalog.sourceLength;
+    const char *lineEnd = memchr(line, '\n', end - line);
+
+    return lineEnd ? lineEnd : end;
+}
+
+/**
+ * @brief Interna os gêneros das linhas ainda não decodificadas, sem decodificá-las.
+ *
+ * Só acontece uma vez, quando uma consulta por nome de gênero não o
+ * encontra entre os já internados: a carga não paga por isso.
+ */
+static void ScanGenres(void)
+{
+    catalog.genresScanned = 1;
+
+    for (int i = 0; i < catalog.count; i++)
+    {
+        if (catalog.titles[i] != NOT_DECODED)
+            continue;
+
+        const char *line = catalog.source + catalog.offsets[i];
+        const char *lineEnd = LineEndOf(line);
+        const char *title = SkipField(line, lineEnd) + 1;
+        const char *author = SkipField(title, lineEnd) + 1;
+        const char *genre = SkipField(author, lineEnd) + 1;
+        const char *year = SkipField(genre, lineEnd) + 1;
+        assert(year <= lineEnd);
+
+        InternFieldGenre(genre, year);
+    }
+}
+
+int FindGenreBook(char *genre)
+{
+    assert(genre);
+    int id = LookupGenre(genre);
+
+    // No modo preguiçoso o gênero pode estar só em linhas ainda não decodificadas.
+    if (id < 0 && catalog.source && !catalog.genresScanned)
+    {
+        ScanGenres();
+        id = LookupGenre(genre);
+    }
+
+    return id;
+}
+
+int MapBooks(FILE *file)
+{
+    assert(file);
+    assert(!catalog.count && !catalog.source);
+    struct stat info;
+    long start = ftell(file);
+
+    if (fstat(fileno(file), &info) != 0 || start < 0 || info.st_size <= start)
+        return 0;
+
+    catalog.sourceLength = info.st_size;
+    catalog.source = mmap(NULL, catalog.sourceLength, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    assert(catalog.source != MAP_FAILED);
+    madvise(catalog.source, catalog.sourceLength, MADV_SEQUENTIAL);
+
+    const char *cur = catalog.source + start;
+    const char *end = catalog.source + catalog.sourceLength;
+
+    // Uma só passada: lê o ID e pula para a próxima linha.
+    while (cur < end)
+    {
+        const char *lineEnd = memchr(cur, '\n', end - cur);
+        lineEnd = lineEnd ? lineEnd : end;
+
+        while (cur < lineEnd && isspace((unsigned char)*cur))
+            cur++;
+
+        if (cur < lineEnd && (isdigit((unsigned char)*cur) || *cur == '-'))
+        {
+            if (catalog.count == catalog.capacity)
+                GrowRows();
+
+            if (catalog.offsetCapacity < catalog.capacity)
+            {
+                catalog.offsets = GrowColumn(catalog.offsets, sizeof(size_t), catalog.offsetCapacity, catalog.capacity);
+                catalog.offsetCapacity = catalog.capacity;
+            }
+
+            int index = catalog.count++;
+            catalog.ids[index] = (int)strtol(cur, NULL, 10);
+            catalog.offsets[index] = cur - catalog.source;
+            catalog.titles[index] = NOT_DECODED;
+            IndexLastRow();
+        }
+
+        cur = lineEnd + 1;
+    }
+
+    return catalog.count;
+}
+
+/**
+ * @brief Decodifica título, autor, gênero e ano de uma linha do arquivo mapeado.
+ */
+static void Decode(int index)
+{
+    const char *line = catalog.source + catalog.offsets[index];
+    const char *lineEnd = LineEndOf(line);
+
+    const char *title = SkipField(line, lineEnd) + 1;
+    const char *author = SkipField(title, lineEnd) + 1;
+    const char *genre = SkipField(author, lineEnd) + 1;
+    const char *year = SkipField(genre, lineEnd) + 1;
+    assert(year <= lineEnd);
+
+    catalog.authors[index] = PushBytes(author, genre - 1 - author);
+    catalog.genres[index] = InternFieldGenre(genre, year);
+    catalog.years[index] = (int)strtol(year, NULL, 10);
+    catalog.titles[index] = PushBytes(title, author - 1 - title);
+}
+
+/**
+ * @brief Posição de um handle, decodificando a linha se ainda estiver só indexada.
+ */
+static int DecodedIndexOf(void *ptr)
+{
+    int index = IndexOf(ptr);
+
+    if (catalog.titles[index] == NOT_DECODED)
+        Decode(index);
+
+    return index;
+}
 
 Book *CreateBook(int id, char *title, char *author, char *gender, int yearOfPublication)
 {
-    Book *book = malloc(sizeof(Book));
-    assert(book);
-    book->id = id;
-    book->title = strdup(title);
-    book->author = strdup(author);
-    book->gender = strdup(gender);
-    book->yearOfPublication = yearOfPublication;
+    if (catalog.count == catalog.capacity)
+        GrowRows();
 
-    return book;
+    int index = catalog.count;
+    catalog.ids[index] = id;
+    catalog.years[index] = yearOfPublication;
+    catalog.genres[index] = InternGenreBook(gender);
+    catalog.titles[index] = PushString(title);
+    catalog.authors[index] = PushString(author);
+    catalog.count++;
+    IndexLastRow();
+
+    return HandleOf(index);
 }
 
 int CompareIdBook(void *ptr, va_list args)
 {
-    Book *book = (Book *)ptr;
-    assert(book);
     int id = va_arg(args, int);
 
-    return book->id == id;
+    return catalog.ids[IndexOf(ptr)] == id;
 }
 
 Book *ReadBook(FILE *file)
@@ -64,21 +417,56 @@ Book *ReadBook(FILE *file)
     return CreateBook(id, title, author, gender, yearOfPublication);
 }
 
-void FreeBook(void *ptr)
+Book *FindBook(int id)
+{
+    if (!catalog.slotCount)
+        return NULL;
+
+    int index = *SlotId(id) - 1;
+
+    return index < 0 ? NULL : HandleOf(index);
+}
+
+int GetCountBooks(void)
+{
+    return catalog.count;
+}
+
+Book *GetByIndexBook(int index)
+{
+    assert(index >= 0 && index < catalog.count);
+    return HandleOf(index);
+}
+
+int GetIndexBook(Book *book)
+{
+    return IndexOf(book);
+}
+
+void FreeCatalogBooks(void)
 {
-    Book *book = (Book *)ptr;
-    assert(book);
-    free(book->title);
-    free(book->author);
-    free(book->gender);
-    free(book);
+    FreeMemory(MEMORY_BOOK, catalog.ids, catalog.capacity * sizeof(int));
+    FreeMemory(MEMORY_BOOK, catalog.years, catalog.capacity * sizeof(int));
+    FreeMemory(MEMORY_BOOK, catalog.genres, catalog.capacity * sizeof(int));
+    FreeMemory(MEMORY_BOOK, catalog.titles, catalog.capacity * sizeof(unsigned));
+    FreeMemory(MEMORY_BOOK, catalog.authors, catalog.capacity * sizeof(unsigned));
+    FreeMemory(MEMORY_BOOK, catalog.slots, catalog.slotCount * sizeof(int));
+    FreeMemory(MEMORY_BOOK, catalog.genreNames, catalog.genreCapacity * sizeof(unsigned));
+    FreeMemory(MEMORY_BOOK, catalog.heap, catalog.heapCapacity);
+
+    if (catalog.source)
+    {
+        FreeMemory(MEMORY_BOOK, catalog.offsets, catalog.offsetCapacity * sizeof(size_t));
+        munmap(catalog.source, catalog.sourceLength);
+    }
+
+    memset(&catalog, 0, sizeof(catalog));
 }
 
 void PrintBook(void *ptr, int isLast)
 {
-    Book *book = (Book *)ptr;
-    assert(book);
-    printf("%s", book->title);
+    int index = DecodedIndexOf(ptr);
+    printf("%s", catalog.heap + catalog.titles[index]);
 
     if (!isLast)
     {
@@ -88,25 +476,45 @@ void PrintBook(void *ptr, int isLast)
 
 int GetIdBook(void *ptr)
 {
-    Book *book = (Book *)ptr;
-    assert(book);
-    return book->id;
+    return catalog.ids[IndexOf(ptr)];
 }
 
 int CompareBooks(void *ptr1, void *ptr2)
 {
-    assert(ptr1);
-    assert(ptr2);
+    return catalog.ids[IndexOf(ptr1)] == catalog.ids[IndexOf(ptr2)];
+}
 
-    Book *book1 = (Book *)ptr1;
-    Book *book2 = (Book *)ptr2;
+char *GetTitleBook(Book *book)
+{
+    int index = DecodedIndexOf(book);
 
-    return book1->id == book2->id;
+    return catalog.heap + catalog.titles[index];
 }
 
-char *GetTitleBook(Book *book)
+char *GetAuthorBook(Book *book)
 {
-    assert(book);
+    int index = DecodedIndexOf(book);
+
+    return catalog.heap + catalog.authors[index];
+}
 
-    return book->title;
-}
\ No newline at end of file
+int GetYearBook(Book *book)
+{
+    return catalog.years[DecodedIndexOf(book)];
+}
+
+int GetGenreBook(Book *book)
+{
+    return catalog.genres[DecodedIndexOf(book)];
+}
+
+int GetCountGenresBook(void)
+{
+    return catalog.genreCount;
+}
+
+char *GetGenreNameBook(int genre)
+{
+    assert(genre >= 0 && genre < catalog.genreCount);
+    return catalog.heap + catalog.genreNames[genre];
+}
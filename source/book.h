@@ -1,7 +1,7 @@
 /**
  * @file book.h
  * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
- * @brief Header file for functions that manipulate the book struct.
+ * @brief Header file for functions that manipulate the columnar book catalog.
  * @version 0.1
  * @date 2025-05-31
  *
@@ -24,18 +24,24 @@
 
 /**
  * @brief Tipo opaco que representa um livro.
+ *
+ * Os livros ficam num catálogo colunar único (um vetor por campo: IDs,
+ * anos, gêneros internados e deslocamentos de título/autor num único
+ * heap de strings). Um Book* é só um handle para uma linha do catálogo
+ * (posição + 1, nunca NULL) e nunca é desreferenciado: todo acesso passa
+ * pelas funções abaixo, que leem apenas a coluna necessária.
  */
 typedef struct book Book;
 
 /**
- * @brief Cria um novo livro.
+ * @brief Acrescenta um livro ao catálogo.
  *
  * @param id                 ID único do livro.
  * @param title              Título do livro.
  * @param author             Nome do autor.
- * @param gender             Gênero literário.
+ * @param gender             Gênero literário (internado: gêneros iguais têm o mesmo ID).
  * @param yearOfPublication  Ano de publicação.
- * @return Ponteiro para o novo Book, ou NULL em caso de falha.
+ * @return Handle do novo livro.
  */
 Book *CreateBook(int id, char *title, char *author, char *gender, int yearOfPublication);
 
@@ -49,19 +55,87 @@ Book *CreateBook(int id, char *title, char *author, char *gender, int yearOfPubl
 int CompareIdBook(void *book, va_list args);
 
 /**
- * @brief Lê um livro de um arquivo de texto.
+ * @brief Lê um livro de um arquivo de texto e o acrescenta ao catálogo.
  *
  * @param file Ponteiro para arquivo FILE aberto em modo leitura.
- * @return Ponteiro para Book lido, ou NULL se EOF.
+ * @return Handle do livro lido, ou NULL se EOF.
  */
 Book *ReadBook(FILE *file);
 
 /**
- * @brief Libera a memória associada a um Book.
+ * @def BOOK_LAZY_ENV
+ * @brief Variável de ambiente que liga a carga preguiçosa do catálogo (ver MapBooks).
+ *
+ * Qualquer valor não vazio e diferente de "0" liga o modo.
+ */
+#define BOOK_LAZY_ENV "BOOKED_LAZY_BOOKS"
+
+/**
+ * @brief Verifica se BOOK_LAZY_ENV pede a carga preguiçosa.
+ *
+ * @return 1 se pedida, 0 caso contrário.
+ */
+int IsLazyBooks(void);
+
+/**
+ * @brief Carrega o catálogo de forma preguiçosa a partir de um arquivo aberto.
+ *
+ * Mapeia o arquivo inteiro (mmap) e, numa única passada a partir da
+ * posição atual de @p file (já depois do cabeçalho), guarda só o ID e a
+ * posição de cada linha. Título, autor, gênero e ano são decodificados
+ * na primeira vez em que alguém os pede (GetTitleBook, GetGenreBook,
+ * etc.). O mapeamento dura até FreeCatalogBooks; @p file pode ser fechado.
+ *
+ * Nesse modo os gêneros são internados conforme as linhas são
+ * decodificadas (os IDs não seguem a ordem do arquivo), e os índices por
+ * gênero (rankings de bookindex.h) só veem os livros que já entraram
+ * neles, que são justamente os decodificados. FindGenreBook cobre o
+ * gênero que só aparece em linhas não decodificadas.
+ *
+ * @param file Arquivo de livros aberto, posicionado após o cabeçalho.
+ * @return Quantidade de livros indexados.
+ */
+int MapBooks(FILE *file);
+
+/**
+ * @brief Busca um livro pelo ID numa tabela hash aberta (ID -> posição).
+ *
+ * A tabela é mantida a cada livro acrescentado (CreateBook, MapBooks),
+ * então a busca é O(1) esperado mesmo com IDs esparsos ou fora de ordem.
+ * Com IDs repetidos, encontra o primeiro carregado.
  *
- * @param book Ponteiro para Book a ser liberado.
+ * @param id ID do livro.
+ * @return Handle do livro, ou NULL se não existir.
+ */
+Book *FindBook(int id);
+
+/**
+ * @brief Obtém a quantidade de livros no catálogo.
+ *
+ * @return Quantidade de livros.
+ */
+int GetCountBooks(void);
+
+/**
+ * @brief Obtém o livro de uma posição do catálogo (ordem de carga).
+ *
+ * @param index Posição, de 0 a GetCountBooks() - 1.
+ * @return Handle do livro.
+ */
+Book *GetByIndexBook(int index);
+
+/**
+ * @brief Obtém a posição de um livro no catálogo.
+ *
+ * @param book Handle do livro.
+ * @return Posição, de 0 a GetCountBooks() - 1.
+ */
+int GetIndexBook(Book *book);
+
+/**
+ * @brief Libera o catálogo inteiro; todos os handles deixam de valer.
  */
-void FreeBook(void *book);
+void FreeCatalogBooks(void);
 
 /**
  * @brief Imprime as informações de um livro.
@@ -91,7 +165,72 @@ int CompareBooks(void *book1, void *book2);
 /**
  * @brief Obtém o título de um livro.
  *
+ * A string fica no heap do catálogo e só é válida até o próximo
+ * CreateBook ou a próxima decodificação preguiçosa (que podem realocar
+ * o heap).
+ *
  * @param book Ponteiro para Book.
  * @return Ponteiro para string contendo o título.
  */
 char *GetTitleBook(Book *book);
+
+/**
+ * @brief Obtém o autor de um livro (mesma validade de GetTitleBook).
+ *
+ * @param book Handle do livro.
+ * @return Ponteiro para string contendo o autor.
+ */
+char *GetAuthorBook(Book *book);
+
+/**
+ * @brief Obtém o ano de publicação de um livro.
+ *
+ * @param book Handle do livro.
+ * @return Ano de publicação.
+ */
+int GetYearBook(Book *book);
+
+/**
+ * @brief Obtém o ID internado do gênero de um livro.
+ *
+ * @param book Handle do livro.
+ * @return ID do gênero, de 0 a GetCountGenresBook() - 1.
+ */
+int GetGenreBook(Book *book);
+
+/**
+ * @brief Obtém a quantidade de gêneros distintos no catálogo.
+ *
+ * No modo preguiçoso (MapBooks), conta só os internados até agora.
+ *
+ * @return Quantidade de gêneros.
+ */
+int GetCountGenresBook(void);
+
+/**
+ * @brief Interna um gênero, mesmo que nenhum livro o tenha (ex.: preferência de leitor).
+ *
+ * @param genre Nome do gênero.
+ * @return ID do gênero (o existente, se já internado).
+ */
+int InternGenreBook(char *genre);
+
+/**
+ * @brief Busca o ID internado de um gênero pelo nome.
+ *
+ * No modo preguiçoso (MapBooks), a primeira busca que não encontra o
+ * nome interna de uma vez os gêneros das linhas ainda não decodificadas,
+ * sem decodificar o resto delas.
+ *
+ * @param genre Nome do gênero.
+ * @return ID do gênero, ou -1 se nenhum livro ou leitor o tem.
+ */
+int FindGenreBook(char *genre);
+
+/**
+ * @brief Obtém o nome de um gênero internado (mesma validade de GetTitleBook).
+ *
+ * @param genre ID do gênero.
+ * @return Nome do gênero.
+ */
+char *GetGenreNameBook(int genre);
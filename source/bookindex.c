@@ -0,0 +1,317 @@
+/**
+ * @file bookindex.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the reverse index from each book to its readers and wishers, and their popularity rankings.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "bookindex.h"
+#include "book.h"
+#include "memory.h"
+
+#define LEVEL_OVERALL 0
+#define LEVEL_GENRE 1
+#define LEVEL_COUNT 2
+
+typedef struct
+{
+    int *positions;
+    int count;
+    int capacity;
+    int slot[LEVEL_COUNT]; // posição do livro em cada Ranking (geral e do gênero)
+} Posting;
+
+/**
+ * @brief Livros de uma lista ordenados pela contagem, em faixas de contagem igual.
+ *
+ * order guarda os livros da maior contagem para a menor; first[c] e
+ * width[c] delimitam a faixa dos livros com contagem c. Para somar 1 à
+ * contagem de um livro basta trocá-lo com o primeiro da sua faixa e
+ * mover a fronteira entre as faixas c e c + 1: O(1), sem reordenar.
+ */
+typedef struct
+{
+    int *order;
+    int size;
+    int capacity;
+    int *first;
+    int *width;
+    int countCapacity;
+} Ranking;
+
+typedef struct
+{
+    Posting *postings[BOOKINDEX_COUNT]; // um por livro do catálogo
+    int bookCapacity;
+    Ranking overall[BOOKINDEX_COUNT];
+    Ranking *genres[BOOKINDEX_COUNT]; // um por gênero internado
+    int genreCapacity;
+} BookIndex;
+
+static BookIndex reverse = {0};
+
+static void GrowBooks(int book)
+{
+    int capacity = reverse.bookCapacity ? reverse.bookCapacity : 64;
+
+    while (capacity <= book)
+        capacity *= 2;
+
+    for (int list = 0; list < BOOKINDEX_COUNT; list++)
+    {
+        reverse.postings[list] = ReallocMemory(MEMORY_INDEX, reverse.postings[list],
+                                             reverse.bookCapacity * sizeof(Posting), capacity * sizeof(Posting));
+        memset(reverse.postings[list] + reverse.bookCapacity, 0, (capacity - reverse.bookCapacity) * sizeof(Posting));
+    }
+
+    reverse.bookCapacity = capacity;
+}
+
+static void GrowGenres(int genre)
+{
+    int capacity = reverse.genreCapacity ? reverse.genreCapacity : 8;
+
+    while (capacity <= genre)
+        capacity *= 2;
+
+    for (int list = 0; list < BOOKINDEX_COUNT; list++)
+    {
+        reverse.genres[list] = ReallocMemory(MEMORY_INDEX, reverse.genres[list],
+                                             reverse.genreCapacity * sizeof(Ranking), capacity * sizeof(Ranking));
+        memset(reverse.genres[list] + reverse.genreCapacity, 0, (capacity - reverse.genreCapacity) * sizeof(Ranking));
+    }
+
+    reverse.genreCapacity = capacity;
+}
+
+static int *SlotOf(int list, int level, int book)
+{
+    return &reverse.postings[list][book].slot[level];
+}
+
+/**
+ * @brief Soma 1 à contagem de @p book em @p ranking (a contagem nova já está na Posting).
+ */
+static void Promote(Ranking *ranking, int list, int level, int book)
+{
+    int count = reverse.postings[list][book].count;
+
+    if (count + 1 > ranking->countCapacity)
+    {
+        int capacity = ranking->countCapacity ? 2 * ranking->countCapacity : 8;
+        ranking->first = ReallocMemory(MEMORY_INDEX, ranking->first,
+                                       ranking->countCapacity * sizeof(int), capacity * sizeof(int));
+        ranking->width = ReallocMemory(MEMORY_INDEX, ranking->width,
+                                       ranking->countCapacity * sizeof(int), capacity * sizeof(int));
+        memset(ranking->width + ranking->countCapacity, 0, (capacity - ranking->countCapacity) * sizeof(int));
+        ranking->countCapacity = capacity;
+    }
+
+    if (count == 1)
+    {
+        // Primeira vez: entra no fim, na faixa de contagem 0.
+        if (ranking->size == ranking->capacity)
+        {
+            int capacity = ranking->capacity ? 2 * ranking->capacity : 16;
+            ranking->order = ReallocMemory(MEMORY_INDEX, ranking->order,
+                                           ranking->capacity * sizeof(int), capacity * sizeof(int));
+            ranking->capacity = capacity;
+        }
+
+        if (!ranking->width[0])
+            ranking->first[0] = ranking->size;
+
+        *SlotOf(list, level, book) = ranking->size;
+        ranking->order[ranking->size++] = book;
+        ranking->width[0]++;
+    }
+
+    int old = count - 1;
+    int slot = *SlotOf(list, level, book);
+    int head = ranking->first[old];
+    int other = ranking->order[head];
+
+    // Troca com o primeiro da faixa antiga, que passa a ser a última posição da nova.
+    ranking->order[slot] = other;
+    *SlotOf(list, level, other) = slot;
+    ranking->order[head] = book;
+    *SlotOf(list, level, book) = head;
+
+    ranking->width[old]--;
+    ranking->first[old] = head + 1;
+
+    if (!ranking->width[count])
+        ranking->first[count] = head;
+
+    ranking->width[count]++;
+}
+
+void AddBookIndex(int list, int book, int position)
+{
+    assert(list >= 0 && list < BOOKINDEX_COUNT);
+    assert(book >= 0);
+    assert(position >= 0);
+
+    if (book >= reverse.bookCapacity)
+        GrowBooks(book);
+
+    Posting *posting = &reverse.postings[list][book];
+
+    if (posting->count == posting->capacity)
+    {
+        int capacity = posting->capacity ? 2 * posting->capacity : 4;
+        posting->positions = ReallocMemory(MEMORY_INDEX, posting->positions,
+                                           posting->capacity * sizeof(int), capacity * sizeof(int));
+        posting->capacity = capacity;
+    }
+
+    posting->positions[posting->count++] = position;
+
+    int genre = GetGenreBook(GetByIndexBook(book));
+
+    if (genre >= reverse.genreCapacity)
+        GrowGenres(genre);
+
+    Promote(&reverse.overall[list], list, LEVEL_OVERALL, book);
+    Promote(&reverse.genres[list][genre], list, LEVEL_GENRE, book);
+}
+
+int GetBookIndex(int list, int book, int **positions)
+{
+    assert(list >= 0 && list < BOOKINDEX_COUNT);
+    assert(positions);
+
+    if (book < 0 || book >= reverse.bookCapacity)
+    {
+        *positions = NULL;
+        return 0;
+    }
+
+    *positions = reverse.postings[list][book].positions;
+
+    return reverse.postings[list][book].count;
+}
+
+static Ranking *RankingOf(int list, int genre)
+{
+    if (genre < 0)
+        return &reverse.overall[list];
+
+    return genre < reverse.genreCapacity ? &reverse.genres[list][genre] : NULL;
+}
+
+int GetTopBookIndex(int list, int genre, int k, int *books)
+{
+    assert(list >= 0 && list < BOOKINDEX_COUNT);
+    assert(books);
+    Ranking *ranking = RankingOf(list, genre);
+    int count = ranking && k < ranking->size ? k : ranking ? ranking->size : 0;
+
+    // Os primeiros de order já são os K maiores: nada a ordenar.
+    for (int i = 0; i < count; i++)
+        books[i] = ranking->order[i];
+
+    return count;
+}
+
+int GetRankBookIndex(int list, int book, int byGenre)
+{
+    assert(list >= 0 && list < BOOKINDEX_COUNT);
+    int count = GetCountBookIndex(list, book);
+
+    if (!count)
+        return 0;
+
+    Ranking *ranking = RankingOf(list, byGenre ? GetGenreBook(GetByIndexBook(book)) : -1);
+
+    return ranking->first[count] + 1;
+}
+
+int GetCountBookIndex(int list, int book)
+{
+    assert(list >= 0 && list < BOOKINDEX_COUNT);
+
+    return book >= 0 && book < reverse.bookCapacity ? reverse.postings[list][book].count : 0;
+}
+
+void PrintTopBookIndex(int list, int genre, int k)
+{
+    assert(k > 0);
+    int *books = AllocMemory(MEMORY_SCRATCH, k * sizeof(int));
+    int count = GetTopBookIndex(list, genre, k, books);
+
+    printf("%s", list == BOOKINDEX_READERS ? "Mais lidos" : "Mais desejados");
+
+    if (genre >= 0)
+        printf(" em %s", GetGenreNameBook(genre));
+
+    printf(": ");
+
+    if (!count)
+        printf("Nenhum livro");
+
+    for (int i = 0; i < count; i++)
+        printf("%s (%d)%s", GetTitleBook(GetByIndexBook(books[i])), GetCountBookIndex(list, books[i]),
+               i < count - 1 ? ", " : "");
+
+    printf("\n");
+    FreeMemory(MEMORY_SCRATCH, books, k * sizeof(int));
+}
+
+static void PrintRank(int list, int book, char *noun)
+{
+    int count = GetCountBookIndex(list, book);
+    printf("%d %s", count, noun);
+
+    if (count)
+        printf(" (%dº geral, %dº em %s)", GetRankBookIndex(list, book, 0), GetRankBookIndex(list, book, 1),
+               GetGenreNameBook(GetGenreBook(GetByIndexBook(book))));
+}
+
+void PrintRankBookIndex(Book *book)
+{
+    assert(book);
+    int index = GetIndexBook(book);
+
+    printf("Popularidade de \"%s\": ", GetTitleBook(book));
+    PrintRank(BOOKINDEX_READERS, index, "leitores");
+    printf(", ");
+    PrintRank(BOOKINDEX_WISHERS, index, "interessados");
+    printf("\n");
+}
+
+static void FreeRanking(Ranking *ranking)
+{
+    FreeMemory(MEMORY_INDEX, ranking->order, ranking->capacity * sizeof(int));
+    FreeMemory(MEMORY_INDEX, ranking->first, ranking->countCapacity * sizeof(int));
+    FreeMemory(MEMORY_INDEX, ranking->width, ranking->countCapacity * sizeof(int));
+}
+
+void FreeBookIndex(void)
+{
+    for (int list = 0; list < BOOKINDEX_COUNT; list++)
+    {
+        for (int book = 0; book < reverse.bookCapacity; book++)
+        {
+            Posting *posting = &reverse.postings[list][book];
+            FreeMemory(MEMORY_INDEX, posting->positions, posting->capacity * sizeof(int));
+        }
+
+        FreeMemory(MEMORY_INDEX, reverse.postings[list], reverse.bookCapacity * sizeof(Posting));
+        FreeRanking(&reverse.overall[list]);
+
+        for (int genre = 0; genre < reverse.genreCapacity; genre++)
+            FreeRanking(&reverse.genres[list][genre]);
+
+        FreeMemory(MEMORY_INDEX, reverse.genres[list], reverse.genreCapacity * sizeof(Ranking));
+    }
+
+    memset(&reverse, 0, sizeof(reverse));
+}
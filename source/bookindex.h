@@ -0,0 +1,111 @@
+/**
+ * @file bookindex.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the reverse index from each book to its readers and wishers, and their popularity rankings.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "book.h"
+
+/**
+ * @brief Listas do índice reverso.
+ */
+#define BOOKINDEX_READERS 0 // leitores que terminaram o livro
+#define BOOKINDEX_WISHERS 1 // leitores que desejam o livro
+#define BOOKINDEX_COUNT 2
+
+/**
+ * @brief Acrescenta um leitor à lista de um livro.
+ *
+ * Cada livro tem um vetor por lista, com as posições dos leitores
+ * (GetIndexUser) em ordem de inserção. Quem chama garante que o leitor
+ * ainda não está na lista.
+ *
+ * @param list     BOOKINDEX_READERS ou BOOKINDEX_WISHERS.
+ * @param book     Posição do livro no catálogo (GetIndexBook).
+ * @param position Posição do leitor.
+ */
+void AddBookIndex(int list, int book, int position);
+
+/**
+ * @brief Obtém a lista de um livro.
+ *
+ * @param list      BOOKINDEX_READERS ou BOOKINDEX_WISHERS.
+ * @param book      Posição do livro no catálogo.
+ * @param positions Recebe o vetor de posições (válido até o próximo AddBookIndex).
+ * @return Quantidade de leitores na lista.
+ */
+int GetBookIndex(int list, int book, int **positions);
+
+/**
+ * @brief Obtém quantos leitores há na lista de um livro.
+ *
+ * @param list BOOKINDEX_READERS ou BOOKINDEX_WISHERS.
+ * @param book Posição do livro no catálogo.
+ * @return Quantidade de leitores (a popularidade do livro nessa lista).
+ */
+int GetCountBookIndex(int list, int book);
+
+/**
+ * @brief Obtém os @p k livros mais populares de uma lista, no geral ou num gênero.
+ *
+ * Cada lista mantém o catálogo ordenado pela contagem em faixas de
+ * contagem igual, atualizadas em O(1) a cada AddBookIndex; a consulta só
+ * copia os primeiros: O(K). Empates ficam em ordem arbitrária, mas estável
+ * para a mesma sequência de comandos. Livros sem nenhum leitor não entram.
+ *
+ * @param list  BOOKINDEX_READERS ou BOOKINDEX_WISHERS.
+ * @param genre ID do gênero (ver FindGenreBook), ou -1 para o catálogo todo.
+ * @param k     Quantidade máxima de livros.
+ * @param books Vetor com espaço para @p k posições de livros.
+ * @return Quantidade de livros escritos em @p books.
+ */
+int GetTopBookIndex(int list, int genre, int k, int *books);
+
+/**
+ * @brief Obtém a colocação de um livro numa lista (empatados dividem a colocação).
+ *
+ * @param list    BOOKINDEX_READERS ou BOOKINDEX_WISHERS.
+ * @param book    Posição do livro no catálogo.
+ * @param byGenre !=0 para a colocação entre os livros do mesmo gênero.
+ * @return Colocação a partir de 1, ou 0 se o livro não tem nenhum leitor na lista.
+ */
+int GetRankBookIndex(int list, int book, int byGenre);
+
+/**
+ * @brief Imprime os @p k livros mais populares de uma lista (ver GetTopBookIndex).
+ *
+ * Formato:
+ * @verbatim
+ * Mais lidos [em <gênero>]: <título> (<contagem>), ...
+ * Mais desejados [em <gênero>]: <título> (<contagem>), ...
+ * @endverbatim
+ *
+ * @param list  BOOKINDEX_READERS ou BOOKINDEX_WISHERS.
+ * @param genre ID do gênero, ou -1 para o catálogo todo.
+ * @param k     Quantidade máxima de livros (> 0).
+ */
+void PrintTopBookIndex(int list, int genre, int k);
+
+/**
+ * @brief Imprime as contagens e colocações de um livro nas duas listas.
+ *
+ * Formato:
+ * @verbatim
+ * Popularidade de "<título>": <n> leitores (<c>º geral, <c>º em <gênero>), <n> interessados (...)
+ * @endverbatim
+ *
+ * @param book Handle do livro.
+ */
+void PrintRankBookIndex(Book *book);
+
+/**
+ * @brief Libera o índice reverso.
+ */
+void FreeBookIndex(void);
@@ -0,0 +1,384 @@
+/**
+ * @file bookset.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the per-user book sets, kept in memory or in a page file.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "bookset.h"
+#include "pager.h"
+
+/**
+ * @brief Tamanho de um bloco da cadeia de um conjunto no arquivo.
+ *
+ * Blocos menores que a página evitam que cada leitor ocupe duas páginas
+ * inteiras só com conjuntos quase vazios.
+ */
+#define BLOCK_SIZE 256
+#define BLOCKS_PER_PAGE (PAGER_PAGE_SIZE / BLOCK_SIZE)
+#define BLOCK_ITEMS ((BLOCK_SIZE - 2 * (int)sizeof(int)) / (int)sizeof(int))
+
+typedef struct
+{
+    int next;  // próximo bloco da cadeia (-1 no último)
+    int count;
+    int items[BLOCK_ITEMS]; // posições dos livros no catálogo (GetIndexBook)
+} Block;
+
+static int initialized = 0;
+static Pager *pager = NULL; // NULL: conjuntos em memória
+static int nextBlock = 0;
+static int freeBlocks = -1; // cadeia de blocos de conjuntos liberados
+static int failed = 0;      // alguma página não pôde ser lida ou gravada (ver TakeErrorBookSet)
+
+static void InitStore(void)
+{
+    initialized = 1;
+    char *path = getenv(BOOKSET_STORE_ENV);
+
+    if (!path || !*path)
+        return;
+
+    char *frames = getenv(BOOKSET_FRAMES_ENV);
+    int frameCount = frames && *frames ? atoi(frames) : BOOKSET_DEFAULT_FRAMES;
+    pager = OpenPager(path, frameCount);
+
+    if (!pager)
+        fprintf(stderr, "Aviso: não foi possível criar %s; conjuntos de livros ficam em memória\n", path);
+}
+
+/**
+ * @brief Fixa a página de um bloco; NULL (e o erro anotado) se a E/S falhar.
+ */
+static Block *PinBlock(int block)
+{
+    char *page = PinPager(pager, block / BLOCKS_PER_PAGE);
+
+    if (!page)
+    {
+        failed = 1;
+        return NULL;
+    }
+
+    return (Block *)(page + (block % BLOCKS_PER_PAGE) * BLOCK_SIZE);
+}
+
+static void UnpinBlock(int block, int dirty)
+{
+    UnpinPager(pager, block / BLOCKS_PER_PAGE, dirty);
+}
+
+/**
+ * @brief Reserva um bloco vazio, da cadeia livre ou do fim do arquivo.
+ *
+ * @return Número do bloco, ou -1 se a E/S falhar (um bloco novo que não
+ *         pôde ser inicializado fica perdido no arquivo).
+ */
+static int AllocBlock(void)
+{
+    int block = freeBlocks;
+
+    if (block >= 0)
+    {
+        Block *data = PinBlock(block);
+
+        if (!data)
+            return -1;
+
+        freeBlocks = data->next;
+        UnpinBlock(block, 0);
+    }
+    else
+    {
+        if (nextBlock % BLOCKS_PER_PAGE == 0)
+            AppendPagePager(pager);
+
+        block = nextBlock++;
+    }
+
+    Block *data = PinBlock(block);
+
+    if (!data)
+        return -1;
+
+    data->next = -1;
+    data->count = 0;
+    UnpinBlock(block, 1);
+
+    return block;
+}
+
+void InitBookSet(BookSet *set)
+{
+    assert(set);
+
+    if (!initialized)
+        InitStore();
+
+    if (!pager)
+    {
+        InitList(&set->list, PrintBook, CompareIdBook);
+        return;
+    }
+
+    set->first = set->last = -1;
+    set->length = 0;
+}
+
+static void AppendTo(Book *book, void *context)
+{
+    AppendBookSet(context, book);
+}
+
+void InitCopyBookSet(BookSet *copy, BookSet *set, int tag)
+{
+    assert(set);
+
+    if (!pager)
+    {
+        InitCopyList(&copy->list, &set->list, tag);
+        return;
+    }
+
+    InitBookSet(copy);
+    ForEachBookSet(set, AppendTo, copy);
+}
+
+int ContainsBookSet(BookSet *set, int idBook)
+{
+    assert(set);
+
+    if (!pager)
+        return FindList(&set->list, idBook) != NULL;
+
+    Book *book = FindBook(idBook);
+
+    if (!book)
+        return 0;
+
+    int index = GetIndexBook(book);
+
+    for (int block = set->first; block >= 0;)
+    {
+        Block *data = PinBlock(block);
+
+        if (!data)
+            return 0;
+
+        int next = data->next;
+        int found = 0;
+
+        for (int i = 0; i < data->count && !found; i++)
+            found = data->items[i] == index;
+
+        UnpinBlock(block, 0);
+
+        if (found)
+            return 1;
+
+        block = next;
+    }
+
+    return 0;
+}
+
+int AppendBookSet(BookSet *set, Book *book)
+{
+    assert(set);
+    assert(book);
+
+    if (!pager)
+    {
+        AppendList(&set->list, book);
+        return 1;
+    }
+
+    if (set->last < 0)
+    {
+        int block = AllocBlock();
+
+        if (block < 0)
+            return 0;
+
+        set->first = set->last = block;
+    }
+
+    Block *data = PinBlock(set->last);
+
+    if (!data)
+        return 0;
+
+    if (data->count == BLOCK_ITEMS)
+    {
+        int block = AllocBlock();
+
+        if (block < 0)
+        {
+            UnpinBlock(set->last, 0);
+            return 0;
+        }
+
+        data->next = block;
+        UnpinBlock(set->last, 1);
+        set->last = block;
+
+        if (!(data = PinBlock(block)))
+            return 0;
+    }
+
+    data->items[data->count++] = GetIndexBook(book);
+    UnpinBlock(set->last, 1);
+    set->length++;
+
+    return 1;
+}
+
+int GetLengthBookSet(BookSet *set)
+{
+    assert(set);
+
+    return pager ? set->length : GetLengthList(&set->list);
+}
+
+void ForEachBookSet(BookSet *set, bookset_fn fn, void *context)
+{
+    assert(set);
+    assert(fn);
+
+    if (!pager)
+    {
+        for (ListCursor cursor = BeginList(&set->list); !IsEndCursor(&cursor); NextCursor(&cursor))
+            fn(GetValueCursor(&cursor), context);
+
+        return;
+    }
+
+    for (int block = set->first; block >= 0;)
+    {
+        // Copia o bloco e solta a página antes de chamar fn, que pode
+        // trazer outras páginas para o buffer pool.
+        Block copy;
+        Block *data = PinBlock(block);
+
+        if (!data)
+            return;
+
+        memcpy(&copy, data, sizeof(Block));
+        UnpinBlock(block, 0);
+
+        for (int i = 0; i < copy.count; i++)
+            fn(GetByIndexBook(copy.items[i]), context);
+
+        block = copy.next;
+    }
+}
+
+typedef struct
+{
+    int remaining;
+} PrintContext;
+
+static void PrintTo(Book *book, void *context)
+{
+    PrintContext *print = context;
+    print->remaining--;
+    PrintBook(book, !print->remaining);
+}
+
+void PrintBookSet(BookSet *set)
+{
+    assert(set);
+
+    if (!pager)
+    {
+        PrintList(&set->list);
+        return;
+    }
+
+    PrintContext print = {set->length};
+    ForEachBookSet(set, PrintTo, &print);
+}
+
+typedef struct
+{
+    BookSet *other;
+    List *common;
+} CommonContext;
+
+static void CollectCommon(Book *book, void *context)
+{
+    CommonContext *common = context;
+
+    if (ContainsBookSet(common->other, GetIdBook(book)))
+        AppendList(common->common, book);
+}
+
+List *GetCommonBookSet(BookSet *set1, BookSet *set2)
+{
+    assert(set1);
+    assert(set2);
+
+    if (!pager)
+        return GetCommonItemsList(&set1->list, &set2->list, CompareIdBook, PrintBook, CompareBooks);
+
+    CommonContext common = {set2, CreateScratchList(PrintBook, CompareIdBook)};
+    ForEachBookSet(set1, CollectCommon, &common);
+
+    return common.common;
+}
+
+void ReleaseBookSet(BookSet *set)
+{
+    assert(set);
+
+    if (!pager)
+    {
+        ReleaseList(&set->list);
+        return;
+    }
+
+    if (set->last >= 0)
+    {
+        // A cadeia inteira entra de uma vez na cadeia de blocos livres
+        // (se a E/S falhar, os blocos ficam perdidos no arquivo).
+        Block *data = PinBlock(set->last);
+
+        if (data)
+        {
+            data->next = freeBlocks;
+            UnpinBlock(set->last, 1);
+            freeBlocks = set->first;
+        }
+    }
+
+    set->first = set->last = -1;
+    set->length = 0;
+}
+
+void FreeStoreBookSets(void)
+{
+    if (pager)
+        ClosePager(pager);
+
+    pager = NULL;
+    initialized = 0;
+    nextBlock = 0;
+    freeBlocks = -1;
+    failed = 0;
+}
+
+int TakeErrorBookSet(void)
+{
+    int error = failed;
+    failed = 0;
+
+    return error;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file bookset.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the per-user book sets, kept in memory or in a page file.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "book.h"
+#include "list.h"
+
+/**
+ * @def BOOKSET_STORE_ENV
+ * @brief Variável de ambiente que guarda os conjuntos de livros fora da memória.
+ *
+ * Com ela definida (caminho de um arquivo), os livros lidos e desejados de
+ * cada leitor ficam num arquivo de páginas (ver pager.h) e só um número
+ * limitado de páginas fica em memória. Sem ela, cada conjunto é uma List.
+ */
+#define BOOKSET_STORE_ENV "BOOKED_USER_STORE"
+
+/**
+ * @def BOOKSET_FRAMES_ENV
+ * @brief Quantidade de páginas do buffer pool no modo em arquivo.
+ */
+#define BOOKSET_FRAMES_ENV "BOOKED_USER_STORE_FRAMES"
+
+/**
+ * @brief Páginas do buffer pool quando BOOKSET_FRAMES_ENV não é definida (1 MiB).
+ */
+#define BOOKSET_DEFAULT_FRAMES 256
+
+/**
+ * @brief Conjunto de livros de um leitor, embutido na struct do leitor.
+ *
+ * Em memória é uma List de Book*. No arquivo é uma cadeia de blocos de
+ * 256 bytes (16 por página) com as posições dos livros no catálogo, em
+ * ordem de inserção; os blocos de conjuntos liberados são reaproveitados.
+ * Os campos só devem ser usados por bookset.c.
+ */
+typedef struct
+{
+    union
+    {
+        List list;
+        struct
+        {
+            int first; // primeiro bloco da cadeia (-1 se vazio)
+            int last;
+            int length;
+        };
+    };
+} BookSet;
+
+/**
+ * @brief Função chamada para cada livro de um conjunto.
+ */
+typedef void (*bookset_fn)(Book *book, void *context);
+
+/**
+ * @brief Inicializa um conjunto vazio.
+ *
+ * Na primeira chamada, lê BOOKSET_STORE_ENV e abre o arquivo de páginas
+ * se pedido; se ele não puder ser criado, os conjuntos ficam em memória.
+ *
+ * @param set Ponteiro para o conjunto.
+ */
+void InitBookSet(BookSet *set);
+
+/**
+ * @brief Inicializa @p copy com os mesmos livros de @p set, na mesma ordem.
+ *
+ * @param copy Conjunto a inicializar.
+ * @param set  Conjunto de origem.
+ * @param tag  Subsistema (MEMORY_*) das células da cópia em memória; no
+ *             arquivo de páginas os blocos voltam à lista livre em ReleaseBookSet.
+ */
+void InitCopyBookSet(BookSet *copy, BookSet *set, int tag);
+
+/**
+ * @brief Verifica se um livro está no conjunto.
+ *
+ * @param set    Ponteiro para o conjunto.
+ * @param idBook ID do livro.
+ * @return 1 se estiver, 0 caso contrário.
+ */
+int ContainsBookSet(BookSet *set, int idBook);
+
+/**
+ * @brief Acrescenta um livro ao fim do conjunto (sem verificar duplicatas).
+ *
+ * @param set  Ponteiro para o conjunto.
+ * @param book Handle do livro.
+ * @return 1 se acrescentou, 0 se a E/S do arquivo de páginas falhou
+ *         (o conjunto fica como estava).
+ */
+int AppendBookSet(BookSet *set, Book *book);
+
+/**
+ * @brief Obtém a quantidade de livros no conjunto.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @return Quantidade de livros.
+ */
+int GetLengthBookSet(BookSet *set);
+
+/**
+ * @brief Chama @p fn para cada livro, em ordem de inserção.
+ *
+ * @p fn pode consultar outros conjuntos, mas não deve alterar @p set.
+ *
+ * @param set     Ponteiro para o conjunto.
+ * @param fn      Função chamada para cada livro.
+ * @param context Repassado a @p fn.
+ */
+void ForEachBookSet(BookSet *set, bookset_fn fn, void *context);
+
+/**
+ * @brief Imprime os títulos do conjunto, separados por vírgula.
+ *
+ * @param set Ponteiro para o conjunto.
+ */
+void PrintBookSet(BookSet *set);
+
+/**
+ * @brief Obtém os livros de @p set1 que também estão em @p set2.
+ *
+ * @param set1 Primeiro conjunto (define a ordem do resultado).
+ * @param set2 Segundo conjunto.
+ * @return Lista de rascunho (MEMORY_SCRATCH) de Book*; liberar com FreeList.
+ */
+List *GetCommonBookSet(BookSet *set1, BookSet *set2);
+
+/**
+ * @brief Esvazia o conjunto, devolvendo suas células ou blocos.
+ *
+ * @param set Ponteiro para o conjunto.
+ */
+void ReleaseBookSet(BookSet *set);
+
+/**
+ * @brief Fecha (e apaga) o arquivo de páginas; os conjuntos em arquivo deixam de valer.
+ */
+void FreeStoreBookSets(void);
+
+/**
+ * @brief Informa se alguma leitura ou gravação do arquivo de páginas falhou
+ *        desde a última chamada, e esquece a falha.
+ *
+ * Numa falha, as consultas tratam o bloco que não pôde ser lido como o
+ * fim do conjunto (ContainsBookSet responde 0, ForEachBookSet para ali) e
+ * AppendBookSet não acrescenta nada; cabe a quem executa o comando
+ * perguntar aqui e tratá-lo como falho.
+ *
+ * @return 1 se houve falha, 0 caso contrário.
+ */
+int TakeErrorBookSet(void);
@@ -10,20 +10,45 @@
  */
 
 #include "cell.h"
+#include "memory.h"
+#include "pool.h"
 
 #include <stdlib.h>
 #include <assert.h>
 
+/**
+ * @brief Células reservadas de uma vez em cada bloco dos pools.
+ */
+#define CELLS_PER_BLOCK 1024
+
 struct cell
 {
     void *value;
     Cell *next;
 };
 
-Cell *CreateCell(void *value)
+// Um pool por etiqueta, para a contabilidade continuar separada por subsistema.
+static Pool *pools[MEMORY_TAG_COUNT];
+
+Cell *CreateCell(void *value, int tag)
 {
-    Cell *cell = malloc(sizeof(Cell));
-    assert(cell);
+    assert(tag >= 0 && tag < MEMORY_TAG_COUNT);
+    Cell *cell = NULL;
+
+    // O rascunho é rebobinado a cada comando e as cópias de snapshot voltam
+    // ao malloc quando ele é liberado: nenhum dos dois precisa de reciclagem.
+    if (tag == MEMORY_SCRATCH || tag == MEMORY_SNAPSHOT)
+    {
+        cell = AllocMemory(tag, sizeof(Cell));
+    }
+    else
+    {
+        if (!pools[tag])
+            pools[tag] = CreatePool(tag, sizeof(Cell), CELLS_PER_BLOCK);
+
+        cell = AllocPool(pools[tag]);
+    }
+
     cell->value = value;
     cell->next = NULL;
 
@@ -54,10 +79,25 @@ void SetNext(Cell *cell, Cell *next)
     cell->next = next;
 }
 
-void FreeCell(Cell *cell)
+void FreeCell(Cell *cell, int tag)
 {
     assert(cell);
-    free(cell);
+
+    if (tag == MEMORY_SCRATCH || tag == MEMORY_SNAPSHOT)
+        FreeMemory(tag, cell, sizeof(Cell));
+    else
+        ReturnPool(pools[tag], cell);
+}
+
+void FreeCellPools(void)
+{
+    for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+    {
+        if (pools[i])
+            FreePool(pools[i]);
+
+        pools[i] = NULL;
+    }
 }
 
 int IsLast(Cell *cell)
@@ -30,9 +30,10 @@ typedef struct cell Cell;
  * @param value Ponteiro para o dado que a célula deve armazenar.
  *              Não faz cópia; o gerenciamento de memória desse dado
  *              fica a cargo do usuário.
+ * @param tag   Subsistema (MEMORY_*) ao qual a célula é contabilizada.
  * @return Ponteiro para a nova célula; NULL se falha na alocação.
  */
-Cell *CreateCell(void *value);
+Cell *CreateCell(void *value, int tag);
 
 /**
  * @brief Retorna o dado armazenado na célula.
@@ -80,8 +81,18 @@ void SetNext(Cell *cell, Cell *next);
  *
  * @param cell Ponteiro para a célula a ser liberada;
  *             ignora se for NULL.
+ * @param tag  Mesmo subsistema usado em CreateCell.
  */
-void FreeCell(Cell *cell);
+void FreeCell(Cell *cell, int tag);
+
+/**
+ * @brief Libera os pools de onde saem as células.
+ *
+ * As células vêm de um pool por subsistema, o que evita um malloc por
+ * célula. Deve ser chamada no final; células ainda em alguma lista
+ * deixam de valer junto com os pools.
+ */
+void FreeCellPools(void);
 
 /**
  * @brief Verifica se a célula é a última de uma lista.
@@ -1,4 +1,13 @@
 #include "command.h"
+#include "snapshot.h"
+#include "metrics.h"
+#include "memory.h"
+#include "bookindex.h"
+#include "utils.h"
+#include "matrix.h"
+#include "search.h"
+#include "yearindex.h"
+#include "bookset.h"
 
 static command_fn commands[] = {
     format_AddBookToFinishedUser,    // 1
@@ -8,44 +17,134 @@ static command_fn commands[] = {
     format_DenyRecommendedBook,      // 5
     format_PrintSharedBooksUsers,    // 6
     format_AreRelatedUsers,          // 7
-    format_PrintUsers                // 8
+    format_PrintUsers,               // 8
+    NULL,                            // 9: reservado (testes esperam "não reconhecido")
+    format_SuggestBooksUser,         // 10
+    format_PrintPathUsers,           // 11
+    format_PrintSimilarUsers,        // 12
+    format_PrintReadersBook,         // 13
+    format_PrintWishersBook,         // 14
+    format_PrintMostReadBooks,       // 15
+    format_PrintMostWishedBooks,     // 16
+    format_PrintRankBook,            // 17
+    format_WriteSharedMatrix,        // 18
+    format_PrintNearestUsers,        // 19
+    format_SearchTitles,             // 20
+    format_SearchTerms,              // 21
+    format_CountYearsUser,           // 22
+    format_PrintBooksByYear          // 23
 };
 
-int ExecuteCommand(FILE *commandFile, List *userList, List *bookList)
+#define COMMAND_COUNT (int)(sizeof(commands) / sizeof(commands[0]))
+
+static int graphBuilt = 0;
+
+void EnsureAffinityGraph(List *userList)
+{
+    if (graphBuilt)
+        return;
+
+    Probe start = StartProbeMetrics();
+    IterList(userList, ConnectUsers);
+    RecordPhaseMetrics(PHASE_BUILD_GRAPH, &start);
+    graphBuilt = 1;
+}
+
+int ExecuteCommand(FILE *commandFile, List *userList, Journal *journal)
 {
     int op = 0;
     int idUser1 = 0;
     int idBook = 0;
     int idUser2 = 0;
 
+    char text[MAX_LINE_LENGTH] = "";
+
     if (fscanf(commandFile, "%d;%d;%d;%d", &op, &idUser1, &idBook, &idUser2) == EOF)
         return 0;
 
-    if (op < 1 || op > 8)
+    // Argumento textual opcional: só existe se a linha continuar com ';'.
+    fscanf(commandFile, ";%255[^\n]", text);
+
+    if (op < 1 || op > COMMAND_COUNT || !commands[op - 1])
     {
         printf("Erro: Comando %d não reconhecido\n", op);
+        RecordUnknownCommandMetrics();
         return 1;
     }
 
-    commands[op - 1](userList, bookList, idUser1, idBook, idUser2);
+    Probe start = StartProbeMetrics();
+    int status = commands[op - 1](userList, idUser1, idBook, idUser2, text);
+
+    // Com os conjuntos em arquivo, uma página ilegível deixa o resultado incompleto.
+    if (TakeErrorBookSet())
+    {
+        printf("Erro: Falha de leitura ou gravação no arquivo de conjuntos de livros\n");
+        status = COMMAND_FAILED;
+    }
+
+    RecordCommandMetrics(op, status == COMMAND_FAILED, &start);
+    ResetScratchMemory();
+
+    if (status == COMMAND_APPLIED && journal)
+        AppendJournal(journal, op, idUser1, idBook, idUser2);
+
     return 1;
 }
 
-void format_AddBookToFinishedUser(COMMAND_PARAMS)
+static int ReplayMutation(List *userList, int op, int idUser1, int idBook, int idUser2)
+{
+    User *user1 = FindList(userList, idUser1);
+    User *user2 = FindList(userList, idUser2);
+    Book *book = FindBook(idBook);
+
+    if (!user1)
+        return COMMAND_FAILED;
+
+    switch (op)
+    {
+    case 1:
+        return book && InsertFinishedBookUser(user1, book) ? COMMAND_APPLIED : COMMAND_UNCHANGED;
+
+    case 2:
+        return book && InsertWishedBookUser(user1, book) ? COMMAND_APPLIED : COMMAND_UNCHANGED;
+
+    case 3:
+        return book && user2 && InsertRecommendationUser(user1, book, user2) == RECOMMENDATION_INSERTED
+                   ? COMMAND_APPLIED
+                   : COMMAND_UNCHANGED;
+
+    case 4:
+        return user2 && AcceptRecommendationUser(user1, idBook, user2) ? COMMAND_APPLIED : COMMAND_UNCHANGED;
+
+    case 5:
+        return user2 && TakeRecommendationUser(user1, idBook, user2) ? COMMAND_APPLIED : COMMAND_UNCHANGED;
+    }
+
+    return COMMAND_UNCHANGED;
+}
+
+int ReplayCommand(List *userList, int op, int idUser1, int idBook, int idUser2)
+{
+    int status = ReplayMutation(userList, op, idUser1, idBook, idUser2);
+
+    return TakeErrorBookSet() ? COMMAND_FAILED : status;
+}
+
+int format_AddBookToFinishedUser(COMMAND_PARAMS)
 {
     UNIQUE_USER_NOT_NULL(idUser1);
     UNIQUE_BOOK_NOT_NULL(idBook);
-    AddBookToFinishedUser(user, book);
+    return AddBookToFinishedUser(user, book) ? COMMAND_APPLIED : COMMAND_UNCHANGED;
 }
 
-void format_AddBookToWishedUser(COMMAND_PARAMS)
+int format_AddBookToWishedUser(COMMAND_PARAMS)
 {
     UNIQUE_USER_NOT_NULL(idUser1);
     UNIQUE_BOOK_NOT_NULL(idBook);
-    AddBookToWishedUser(user, book);
+    return AddBookToWishedUser(user, book) ? COMMAND_APPLIED : COMMAND_UNCHANGED;
 }
 
-void format_AddBookToRecommendedUser(COMMAND_PARAMS)
+int format_AddBookToRecommendedUser(COMMAND_PARAMS)
 {
     User *recommendindUser = FindList(userList, idUser1);
     User *recommendedUser = FindList(userList, idUser2);
@@ -54,25 +153,25 @@ void format_AddBookToRecommendedUser(COMMAND_PARAMS)
     if (!recommendindUser)
     {
         printf("Erro: Leitor recomendador com ID %d não encontrado\n", idUser1);
-        return;
+        return COMMAND_FAILED;
     }
 
     if (!recommendedUser)
     {
         printf("Erro: Leitor destinatário com ID %d não encontrado\n", idUser2);
-        return;
+        return COMMAND_FAILED;
     }
 
     if (recommendindUser == recommendedUser)
     {
         printf("%s não pode recomendar livros para si mesmo\n", GetNameUser(recommendindUser));
-        return;
+        return COMMAND_FAILED;
     }
 
-    AddBookToRecommendedUser(recommendindUser, book, recommendedUser);
+    return AddBookToRecommendedUser(recommendindUser, book, recommendedUser) ? COMMAND_APPLIED : COMMAND_UNCHANGED;
 }
 
-void format_AcceptRecommendedBook(COMMAND_PARAMS)
+int format_AcceptRecommendedBook(COMMAND_PARAMS)
 {
     User *recommendedUser = FindList(userList, idUser1);
     User *recommendindUser = FindList(userList, idUser2);
@@ -80,19 +179,19 @@ void format_AcceptRecommendedBook(COMMAND_PARAMS)
     if (!recommendindUser)
     {
         printf("Erro: Leitor recomendador com ID %d não encontrado\n", idUser2);
-        return;
+        return COMMAND_FAILED;
     }
 
     if (!recommendedUser)
     {
         printf("Erro: Leitor com ID %d não encontrado\n", idUser1);
-        return;
+        return COMMAND_FAILED;
     }
 
-    AcceptRecommendedBook(recommendedUser, idBook, recommendindUser);
+    return AcceptRecommendedBook(recommendedUser, idBook, recommendindUser) ? COMMAND_APPLIED : COMMAND_UNCHANGED;
 }
 
-void format_DenyRecommendedBook(COMMAND_PARAMS)
+int format_DenyRecommendedBook(COMMAND_PARAMS)
 {
     User *recommendedUser = FindList(userList, idUser1);
     User *recommendindUser = FindList(userList, idUser2);
@@ -100,36 +199,244 @@ void format_DenyRecommendedBook(COMMAND_PARAMS)
     if (!recommendindUser)
     {
         printf("Erro: Leitor recomendador com ID %d não encontrado\n", idUser2);
-        return;
+        return COMMAND_FAILED;
     }
 
     if (!recommendedUser)
     {
         printf("Erro: Leitor com ID %d não encontrado\n", idUser1);
-        return;
+        return COMMAND_FAILED;
     }
 
-    DenyRecommendedBook(recommendedUser, idBook, recommendindUser);
+    return DenyRecommendedBook(recommendedUser, idBook, recommendindUser) ? COMMAND_APPLIED : COMMAND_UNCHANGED;
 }
 
-void format_PrintSharedBooksUsers(COMMAND_PARAMS)
+int format_PrintSharedBooksUsers(COMMAND_PARAMS)
 {
     BOTH_USERS_NOT_NULL(idUser1, idUser2);
     PrintSharedBooksUsers(user1, user2);
+    return COMMAND_UNCHANGED;
 }
 
-void format_AreRelatedUsers(COMMAND_PARAMS)
+int format_AreRelatedUsers(COMMAND_PARAMS)
 {
     BOTH_USERS_NOT_NULL(idUser1, idUser2);
+    EnsureAffinityGraph(userList);
 
     if (AreRelatedUsers(user1, user2))
         printf("Existe afinidade entre %s e %s\n", GetNameUser(user1), GetNameUser(user2));
     else
         printf("Não existe afinidade entre %s e %s\n", GetNameUser(user1), GetNameUser(user2));
+
+    return COMMAND_UNCHANGED;
 }
 
-void format_PrintUsers(COMMAND_PARAMS)
+int format_PrintUsers(COMMAND_PARAMS)
 {
     printf("Imprime toda a BookED\n\n");
-    PrintList(userList);
-}
\ No newline at end of file
+    EnsureAffinityGraph(userList);
+
+    // O dump lê um snapshot: mutações concorrentes copiam o usuário antes de alterá-lo.
+    Snapshot *snapshot = TakeSnapshot(userList);
+    PrintSnapshot(snapshot);
+    ReleaseSnapshot(snapshot);
+    return COMMAND_UNCHANGED;
+}
+
+int format_SuggestBooksUser(COMMAND_PARAMS)
+{
+    UNIQUE_USER_NOT_NULL(idUser1);
+
+    if (idBook <= 0)
+    {
+        printf("Erro: Quantidade de sugestões %d inválida\n", idBook);
+        return COMMAND_FAILED;
+    }
+
+    EnsureAffinityGraph(userList);
+    PrintSuggestionsUser(user, idBook);
+    return COMMAND_UNCHANGED;
+}
+
+int format_PrintPathUsers(COMMAND_PARAMS)
+{
+    BOTH_USERS_NOT_NULL(idUser1, idUser2);
+    EnsureAffinityGraph(userList);
+    PrintPathUsers(user1, user2);
+    return COMMAND_UNCHANGED;
+}
+
+int format_PrintSimilarUsers(COMMAND_PARAMS)
+{
+    UNIQUE_USER_NOT_NULL(idUser1);
+
+    if (idBook <= 0)
+    {
+        printf("Erro: Quantidade de leitores %d inválida\n", idBook);
+        return COMMAND_FAILED;
+    }
+
+    PrintSimilarUsers(user, idBook);
+    return COMMAND_UNCHANGED;
+}
+
+int format_PrintReadersBook(COMMAND_PARAMS)
+{
+    UNIQUE_BOOK_NOT_NULL(idBook);
+    PrintReadersBookUsers(book);
+    return COMMAND_UNCHANGED;
+}
+
+int format_PrintWishersBook(COMMAND_PARAMS)
+{
+    UNIQUE_BOOK_NOT_NULL(idBook);
+    PrintWishersBookUsers(book);
+    return COMMAND_UNCHANGED;
+}
+
+static int PrintTopBooks(int list, int k, char *genreName)
+{
+    int genre = -1;
+
+    if (k <= 0)
+    {
+        printf("Erro: Quantidade de livros %d inválida\n", k);
+        return COMMAND_FAILED;
+    }
+
+    if (*genreName && (genre = FindGenreBook(genreName)) < 0)
+    {
+        printf("Erro: Gênero %s não encontrado\n", genreName);
+        return COMMAND_FAILED;
+    }
+
+    PrintTopBookIndex(list, genre, k);
+    return COMMAND_UNCHANGED;
+}
+
+int format_PrintMostReadBooks(COMMAND_PARAMS)
+{
+    return PrintTopBooks(BOOKINDEX_READERS, idUser1, text);
+}
+
+int format_PrintMostWishedBooks(COMMAND_PARAMS)
+{
+    return PrintTopBooks(BOOKINDEX_WISHERS, idUser1, text);
+}
+
+int format_PrintRankBook(COMMAND_PARAMS)
+{
+    UNIQUE_BOOK_NOT_NULL(idBook);
+    PrintRankBookIndex(book);
+    return COMMAND_UNCHANGED;
+}
+
+int format_WriteSharedMatrix(COMMAND_PARAMS)
+{
+    char *path = *text ? text : MATRIX_DEFAULT_FILE;
+    FILE *out = fopen(path, "w");
+
+    if (!out)
+    {
+        printf("Erro: Não foi possível criar %s\n", path);
+        return COMMAND_FAILED;
+    }
+
+    EnsureAffinityGraph(userList);
+    long pairs = WriteSharedMatrix(userList, out);
+    fclose(out);
+
+    printf("Livros em comum de %ld pares gravados em %s\n", pairs, path);
+    return COMMAND_UNCHANGED;
+}
+
+int format_PrintNearestUsers(COMMAND_PARAMS)
+{
+    UNIQUE_USER_NOT_NULL(idUser1);
+
+    if (idBook <= 0)
+    {
+        printf("Erro: Quantidade de leitores %d inválida\n", idBook);
+        return COMMAND_FAILED;
+    }
+
+    EnsureAffinityGraph(userList);
+    PrintNearestUsers(user, idBook, idUser2);
+    return COMMAND_UNCHANGED;
+}
+
+int format_SearchTitles(COMMAND_PARAMS)
+{
+    if (idUser1 <= 0)
+    {
+        printf("Erro: Quantidade de livros %d inválida\n", idUser1);
+        return COMMAND_FAILED;
+    }
+
+    if (!*text)
+    {
+        printf("Erro: Prefixo vazio\n");
+        return COMMAND_FAILED;
+    }
+
+    PrintTitlePrefixSearch(text, idUser1);
+    return COMMAND_UNCHANGED;
+}
+
+int format_SearchTerms(COMMAND_PARAMS)
+{
+    if (idUser1 <= 0)
+    {
+        printf("Erro: Quantidade de livros %d inválida\n", idUser1);
+        return COMMAND_FAILED;
+    }
+
+    if (!*text)
+    {
+        printf("Erro: Busca vazia\n");
+        return COMMAND_FAILED;
+    }
+
+    PrintTermSearch(text, idUser1);
+    return COMMAND_UNCHANGED;
+}
+
+/**
+ * @brief Valida um intervalo de anos; imprime o erro se inválido.
+ */
+static int IsValidYearRange(int from, int to)
+{
+    if (from > to)
+    {
+        printf("Erro: Intervalo de anos %d a %d inválido\n", from, to);
+        return 0;
+    }
+
+    return 1;
+}
+
+int format_CountYearsUser(COMMAND_PARAMS)
+{
+    UNIQUE_USER_NOT_NULL(idUser1);
+
+    if (!IsValidYearRange(idBook, idUser2))
+        return COMMAND_FAILED;
+
+    PrintYearCountUser(user, idBook, idUser2);
+    return COMMAND_UNCHANGED;
+}
+
+int format_PrintBooksByYear(COMMAND_PARAMS)
+{
+    if (!IsValidYearRange(idUser1, idBook))
+        return COMMAND_FAILED;
+
+    if (idUser2 <= 0)
+    {
+        printf("Erro: Quantidade de livros %d inválida\n", idUser2);
+        return COMMAND_FAILED;
+    }
+
+    PrintRangeYearIndex(idUser1, idBook, idUser2);
+    return COMMAND_UNCHANGED;
+}
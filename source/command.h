@@ -3,6 +3,7 @@
 #include "list.h"
 #include "book.h"
 #include "user.h"
+#include "journal.h"
 
 /**
  * @def COMMAND_SOURCE_FILE
@@ -21,52 +22,70 @@
  *
  * Deve ser usada em todos os protótipos de `format_*`, ex:
  * @code
- * void format_AddBookToFinishedUser(COMMAND_PARAMS);
+ * int format_AddBookToFinishedUser(COMMAND_PARAMS);
  * @endcode
  *
  * Expande para:
  * @code
  * List *userList,
- * List *bookList,
  * int   idUser1,
  * int   idBook,
- * int   idUser2
+ * int   idUser2,
+ * char *text
  * @endcode
  */
-#define COMMAND_PARAMS  \
-    List *userList,     \
-        List *bookList, \
-        int idUser1,    \
-        int idBook,     \
-        int idUser2
+#define COMMAND_PARAMS \
+    List *userList,    \
+        int idUser1,   \
+        int idBook,    \
+        int idUser2,   \
+        char *text
 
 /**
- * @def __UNIQUE_NOT_NULL(type, var, name, list, id)
- * @brief Macro de baixo nível para buscar e validar um ponteiro em uma lista.
+ * @def COMMAND_FAILED
+ * @brief Retorno de um comando que não pôde ser executado (ID inválido, etc.).
+ */
+#define COMMAND_FAILED -1
+
+/**
+ * @def COMMAND_UNCHANGED
+ * @brief Retorno de um comando executado que não alterou o estado.
+ */
+#define COMMAND_UNCHANGED 0
+
+/**
+ * @def COMMAND_APPLIED
+ * @brief Retorno de um comando que alterou o estado (e deve ir para o journal).
+ */
+#define COMMAND_APPLIED 1
+
+/**
+ * @def __UNIQUE_NOT_NULL(type, var, name, lookup, id)
+ * @brief Macro de baixo nível para buscar e validar um ponteiro.
  *
- * - Chama:
+ * - Avalia:
  *   @code
- *   var = FindList(list, id);
+ *   var = lookup;
  *   @endcode
  * - Se o retorno for NULL, imprime:
  *   @verbatim
  *   Erro: <name> com ID <id> não encontrado
  *   @endverbatim
- *   e faz `return;` na função chamadora.
+ *   e faz `return COMMAND_FAILED;` na função chamadora.
  *
  * @param type   Tipo do ponteiro a ser buscado (por ex. User * ou Book *).
- * @param var    Nome da variável local que receberá o resultado de FindList.
+ * @param var    Nome da variável local que receberá o resultado da busca.
  * @param name   String descritiva (ex.: "Leitor" ou "Livro") usada na mensagem de erro.
- * @param list   Ponteiro para a lista onde se busca (userList ou bookList).
- * @param id     Identificador numérico usado como chave de busca.
- */
-#define __UNIQUE_NOT_NULL(type, var, name, list, id)  \
-    type var = FindList(list, id);                    \
-    if (!var)                                         \
-    {                                                 \
-        printf("Erro: %s com ID %d não encontrado\n", \
-               name, id);                             \
-        return;                                       \
+ * @param lookup Expressão de busca (ex.: FindList(userList, id) ou FindBook(id)).
+ * @param id     Identificador numérico usado na mensagem de erro.
+ */
+#define __UNIQUE_NOT_NULL(type, var, name, lookup, id) \
+    type var = lookup;                                 \
+    if (!var)                                          \
+    {                                                  \
+        printf("Erro: %s com ID %d não encontrado\n",  \
+               name, id);                              \
+        return COMMAND_FAILED;                         \
     }
 
 /**
@@ -78,14 +97,14 @@
  * User *user = FindList(userList, id);
  * if (!user) {
  *     printf("Erro: Leitor com ID %d não encontrado\n", id);
- *     return;
+ *     return COMMAND_FAILED;
  * }
  * @endcode
  *
  * @param id  ID do leitor a procurar.
  */
 #define UNIQUE_USER_NOT_NULL(id) \
-    __UNIQUE_NOT_NULL(User *, user, "Leitor", userList, id)
+    __UNIQUE_NOT_NULL(User *, user, "Leitor", FindList(userList, id), id)
 
 /**
  * @def BOTH_USERS_NOT_NULL(id1, id2)
@@ -100,27 +119,27 @@
  * @param id1  ID do primeiro leitor (por ex. destinatário ou aceitante).
  * @param id2  ID do segundo leitor (por ex. recomendador).
  */
-#define BOTH_USERS_NOT_NULL(id1, id2)                         \
-    __UNIQUE_NOT_NULL(User *, user1, "Leitor", userList, id1) \
-    __UNIQUE_NOT_NULL(User *, user2, "Leitor", userList, id2)
+#define BOTH_USERS_NOT_NULL(id1, id2)                                          \
+    __UNIQUE_NOT_NULL(User *, user1, "Leitor", FindList(userList, id1), id1) \
+    __UNIQUE_NOT_NULL(User *, user2, "Leitor", FindList(userList, id2), id2)
 
 /**
  * @def UNIQUE_BOOK_NOT_NULL(id)
- * @brief Busca um Book* em bookList pelo ID e valida não-NULL.
+ * @brief Busca um Book* no catálogo pelo ID e valida não-NULL.
  *
  * Equivalente a:
  * @code
- * Book *book = FindList(bookList, id);
+ * Book *book = FindBook(id);
  * if (!book) {
  *     printf("Erro: Livro com ID %d não encontrado\n", id);
- *     return;
+ *     return COMMAND_FAILED;
  * }
  * @endcode
  *
  * @param id  ID do livro a procurar.
  */
 #define UNIQUE_BOOK_NOT_NULL(id) \
-    __UNIQUE_NOT_NULL(Book *, book, "Livro", bookList, id)
+    __UNIQUE_NOT_NULL(Book *, book, "Livro", FindBook(id), id)
 
 /**
  * @typedef command_fn
@@ -128,38 +147,73 @@
  *
  * Uma função desse tipo recebe:
  *   - @p userList: lista de todos os usuários cadastrados.
- *   - @p bookList: lista de todos os livros cadastrados.
  *   - @p idUser1: ID do usuário principal (quem inicia a ação).
  *   - @p idBook:   ID do livro alvo da ação (quando aplicável).
  *   - @p idUser2: ID do segundo usuário envolvido (quando aplicável).
+ *   - @p text:    argumento textual opcional (string vazia se ausente).
+ *
+ * E retorna COMMAND_FAILED, COMMAND_UNCHANGED ou COMMAND_APPLIED.
  */
-typedef void (*command_fn)(COMMAND_PARAMS);
+typedef int (*command_fn)(COMMAND_PARAMS);
+
+/**
+ * @brief Constrói o grafo de afinidades na primeira vez em que é chamada.
+ *
+ * O grafo só depende das preferências, que não mudam depois da carga;
+ * por isso ele é adiado até o primeiro comando que o lê (7, 8, 10, 11, 18, 19), e lotes
+ * só de escrita (comandos 1 a 5) começam sem pagar o custo quadrático.
+ * O tempo de construção vai para a fase PHASE_BUILD_GRAPH.
+ *
+ * @param userList Lista de usuários já carregada.
+ */
+void EnsureAffinityGraph(List *userList);
 
 /**
  * @brief Lê e executa um comando do arquivo de comandos.
  *
  * Cada linha do arquivo deve ter o formato:
- *   op;idUser1;idBook;idUser2
+ *   op;idUser1;idBook;idUser2[;texto]
  * onde:
- *   - @p op é o código da operação (1 a 8),
+ *   - @p op é o código da operação (1 a 8 e de 10 em diante; 9 não é usado),
  *   - @p idUser1 e @p idUser2 são IDs de usuários (ou 0 se não usados),
- *   - @p idBook é o ID de um livro (ou 0 se não usado).
+ *   - @p idBook é o ID de um livro (ou 0 se não usado),
+ *   - texto é um argumento opcional até o fim da linha (gênero, prefixo, etc.).
  *
  * A função:
- *   1. Lê quatro inteiros do @p commandFile.
+ *   1. Lê quatro inteiros do @p commandFile e o texto opcional.
  *   2. Se atingir EOF, retorna 0 para parar o processamento.
  *   3. Valida @p op dentro do intervalo de comandos disponíveis
  *      e chama o handler correspondente.
- *   4. Retorna 1 para continuar processando o próximo comando.
+ *   4. Se o arquivo de conjuntos de livros falhou durante o comando (ver
+ *      TakeErrorBookSet), imprime o erro e trata o comando como COMMAND_FAILED.
+ *   5. Se o handler retornar COMMAND_APPLIED e houver @p journal,
+ *      registra a mutação no journal.
+ *   6. Retorna 1 para continuar processando o próximo comando.
  *
  * @param commandFile  Ponteiro para o arquivo de comandos (já aberto e sem cabeçalho).
  * @param userList     Lista de todos os usuários do sistema.
- * @param bookList     Lista de todos os livros do sistema.
+ * @param journal      Journal de mutações, ou NULL se desligado.
  * @return             0 se EOF for alcançado (encerra loop), 1 caso contrário.
  */
 int ExecuteCommand(FILE *commandFile,
                    List *userList,
-                   List *bookList);
+                   Journal *journal);
+
+/**
+ * @brief Reaplica uma mutação registrada no journal, sem imprimir nada.
+ *
+ * Só os comandos 1 a 5 alteram estado; os demais são ignorados.
+ *
+ * @param userList Lista de usuários.
+ * @param op       Código do comando.
+ * @param idUser1  Primeiro ID de usuário.
+ * @param idBook   ID do livro.
+ * @param idUser2  Segundo ID de usuário.
+ * @return COMMAND_APPLIED se o estado foi alterado, COMMAND_UNCHANGED
+ *         ou COMMAND_FAILED caso contrário (inclusive falha de E/S no
+ *         arquivo de conjuntos de livros).
+ */
+int ReplayCommand(List *userList, int op, int idUser1, int idBook, int idUser2);
 
 /**
  * @brief Comando 1: marca um livro como já lido por um usuário.
@@ -168,12 +222,11 @@ int ExecuteCommand(FILE *commandFile,
  *   AddBookToFinishedUser(user, book);
  *
  * @param userList   Lista de usuários.
- * @param bookList   Lista de livros.
  * @param idUser1    ID do usuário que terminou de ler o livro.
  * @param idBook     ID do livro concluído.
  * @param idUser2    Ignorado (deve ser 0).
  */
-void format_AddBookToFinishedUser(COMMAND_PARAMS);
+int format_AddBookToFinishedUser(COMMAND_PARAMS);
 
 /**
  * @brief Comando 2: adiciona um livro à lista de desejos de um usuário.
@@ -182,12 +235,11 @@ void format_AddBookToFinishedUser(COMMAND_PARAMS);
  *   AddBookToWishedUser(user, book);
  *
  * @param userList   Lista de usuários.
- * @param bookList   Lista de livros.
  * @param idUser1    ID do usuário que deseja o livro.
  * @param idBook     ID do livro desejado.
  * @param idUser2    Ignorado (deve ser 0).
  */
-void format_AddBookToWishedUser(COMMAND_PARAMS);
+int format_AddBookToWishedUser(COMMAND_PARAMS);
 
 /**
  * @brief Comando 3: recomenda um livro de um usuário para outro.
@@ -200,12 +252,11 @@ void format_AddBookToWishedUser(COMMAND_PARAMS);
  *   AddBookToRecommendedUser(recommendendor, book, destinatario);
  *
  * @param userList   Lista de usuários.
- * @param bookList   Lista de livros.
  * @param idUser1    ID do usuário que faz a recomendação.
  * @param idBook     ID do livro recomendado.
  * @param idUser2    ID do usuário que receberá a recomendação.
  */
-void format_AddBookToRecommendedUser(COMMAND_PARAMS);
+int format_AddBookToRecommendedUser(COMMAND_PARAMS);
 
 /**
  * @brief Comando 4: aceita uma recomendação pendente.
@@ -218,12 +269,11 @@ void format_AddBookToRecommendedUser(COMMAND_PARAMS);
  *   AcceptRecommendedBook(destinatario, book, recomendador);
  *
  * @param userList   Lista de usuários.
- * @param bookList   Lista de livros.
  * @param idUser1    ID do usuário que aceita a recomendação.
  * @param idBook     ID do livro aceito.
  * @param idUser2    ID do usuário que fez a recomendação.
  */
-void format_AcceptRecommendedBook(COMMAND_PARAMS);
+int format_AcceptRecommendedBook(COMMAND_PARAMS);
 
 /**
  * @brief Comando 5: nega uma recomendação pendente.
@@ -236,12 +286,11 @@ void format_AcceptRecommendedBook(COMMAND_PARAMS);
  *   DenyRecommendedBook(destinatario, book, recomendador);
  *
  * @param userList   Lista de usuários.
- * @param bookList   Lista de livros.
  * @param idUser1    ID do usuário que nega a recomendação.
  * @param idBook     ID do livro negado.
  * @param idUser2    ID do usuário que fez a recomendação.
  */
-void format_DenyRecommendedBook(COMMAND_PARAMS);
+int format_DenyRecommendedBook(COMMAND_PARAMS);
 
 /**
  * @brief Comando 6: imprime livros em comum entre dois usuários.
@@ -250,12 +299,11 @@ void format_DenyRecommendedBook(COMMAND_PARAMS);
  *   PrintSharedBooksUsers(user1, user2);
  *
  * @param userList   Lista de usuários.
- * @param bookList   Ignorada.
  * @param idUser1    ID do primeiro usuário.
  * @param idBook     Ignorado (deve ser 0).
  * @param idUser2    ID do segundo usuário.
  */
-void format_PrintSharedBooksUsers(COMMAND_PARAMS);
+int format_PrintSharedBooksUsers(COMMAND_PARAMS);
 
 /**
  * @brief Comando 7: verifica afinidade entre dois usuários.
@@ -265,23 +313,202 @@ void format_PrintSharedBooksUsers(COMMAND_PARAMS);
  * com base em AreRelatedUsers(user1, user2).
  *
  * @param userList   Lista de usuários.
- * @param bookList   Ignorada.
  * @param idUser1    ID do primeiro usuário.
  * @param idBook     Ignorado (deve ser 0).
  * @param idUser2    ID do segundo usuário.
  */
-void format_AreRelatedUsers(COMMAND_PARAMS);
+int format_AreRelatedUsers(COMMAND_PARAMS);
 
 /**
  * @brief Comando 8: imprime todos os usuários e seus dados.
  *
- * Ignora os parâmetros numéricos e chama:
- *   PrintList(userList);
+ * Ignora os parâmetros numéricos e imprime um snapshot consistente
+ * dos usuários (ver snapshot.h), sem bloquear escritores durante o dump.
  *
  * @param userList   Lista de usuários.
- * @param bookList   Ignorada.
  * @param idUser1    Ignorado (0).
  * @param idBook     Ignorado (0).
  * @param idUser2    Ignorado (0).
  */
-void format_PrintUsers(COMMAND_PARAMS);
+int format_PrintUsers(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 10: sugere livros a partir do que as afinidades leram.
+ *
+ * Valida existência de @p idUser1 e a quantidade em @p idBook, constrói
+ * o grafo se necessário e chama:
+ *   PrintSuggestionsUser(user, idBook);
+ *
+ * @param userList   Lista de usuários.
+ * @param idUser1    ID do usuário que recebe as sugestões.
+ * @param idBook     Quantidade máxima de sugestões (K > 0).
+ * @param idUser2    Ignorado (deve ser 0).
+ */
+int format_SuggestBooksUser(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 11: imprime o menor caminho de afinidades entre dois usuários.
+ *
+ * Valida existência de @p idUser1 e @p idUser2, constrói o grafo se
+ * necessário e chama:
+ *   PrintPathUsers(user1, user2);
+ *
+ * @param userList   Lista de usuários.
+ * @param idUser1    ID do usuário de origem.
+ * @param idBook     Ignorado (deve ser 0).
+ * @param idUser2    ID do usuário de destino.
+ */
+int format_PrintPathUsers(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 12: imprime os leitores com leituras mais parecidas.
+ *
+ * Valida existência de @p idUser1 e a quantidade em @p idBook e chama:
+ *   PrintSimilarUsers(user, idBook);
+ *
+ * @param userList   Lista de usuários.
+ * @param idUser1    ID do usuário consultado.
+ * @param idBook     Quantidade máxima de leitores (K > 0).
+ * @param idUser2    Ignorado (deve ser 0).
+ */
+int format_PrintSimilarUsers(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 13: imprime quem já leu um livro.
+ *
+ * Valida existência de @p idBook e chama:
+ *   PrintReadersBookUsers(book);
+ *
+ * @param userList   Ignorado.
+ * @param idUser1    Ignorado (deve ser 0).
+ * @param idBook     ID do livro.
+ * @param idUser2    Ignorado (deve ser 0).
+ */
+int format_PrintReadersBook(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 14: imprime quem deseja um livro.
+ *
+ * Valida existência de @p idBook e chama:
+ *   PrintWishersBookUsers(book);
+ *
+ * @param userList   Ignorado.
+ * @param idUser1    Ignorado (deve ser 0).
+ * @param idBook     ID do livro.
+ * @param idUser2    Ignorado (deve ser 0).
+ */
+int format_PrintWishersBook(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 15: imprime os livros mais lidos.
+ *
+ * Valida a quantidade em @p idUser1 e, se houver @p text, o gênero, e chama:
+ *   PrintTopBookIndex(BOOKINDEX_READERS, genero, idUser1);
+ *
+ * @param userList   Ignorado.
+ * @param idUser1    Quantidade máxima de livros (K > 0).
+ * @param idBook     Ignorado (deve ser 0).
+ * @param idUser2    Ignorado (deve ser 0).
+ * @param text       Nome do gênero, ou vazio para o catálogo todo.
+ */
+int format_PrintMostReadBooks(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 16: imprime os livros mais desejados (mesmos parâmetros do comando 15).
+ */
+int format_PrintMostWishedBooks(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 17: imprime a popularidade e a colocação de um livro.
+ *
+ * Valida existência de @p idBook e chama:
+ *   PrintRankBookIndex(book);
+ *
+ * @param userList   Ignorado.
+ * @param idUser1    Ignorado (deve ser 0).
+ * @param idBook     ID do livro.
+ * @param idUser2    Ignorado (deve ser 0).
+ */
+int format_PrintRankBook(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 18: grava os livros em comum de todos os pares com afinidade.
+ *
+ * Constrói o grafo se necessário e chama:
+ *   WriteSharedMatrix(userList, arquivo);
+ *
+ * @param userList   Lista de usuários.
+ * @param idUser1    Ignorado (deve ser 0).
+ * @param idBook     Ignorado (deve ser 0).
+ * @param idUser2    Ignorado (deve ser 0).
+ * @param text       Caminho do arquivo, ou vazio para MATRIX_DEFAULT_FILE.
+ */
+int format_WriteSharedMatrix(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 19: imprime as afinidades mais fortes de um usuário.
+ *
+ * Valida existência de @p idUser1 e a quantidade em @p idBook, constrói
+ * o grafo se necessário e chama:
+ *   PrintNearestUsers(user, idBook, idUser2);
+ *
+ * @param userList   Lista de usuários.
+ * @param idUser1    ID do usuário consultado.
+ * @param idBook     Quantidade máxima de leitores (K > 0).
+ * @param idUser2    1 para somar os livros lidos em comum ao peso, 0 para só os gêneros.
+ */
+int format_PrintNearestUsers(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 20: imprime os livros cujo título começa com um prefixo.
+ *
+ * Valida a quantidade em @p idUser1 e o prefixo e chama:
+ *   PrintTitlePrefixSearch(text, idUser1);
+ *
+ * @param userList   Ignorado.
+ * @param idUser1    Quantidade máxima de livros (N > 0).
+ * @param idBook     Ignorado (deve ser 0).
+ * @param idUser2    Ignorado (deve ser 0).
+ * @param text       Prefixo do título (sem diferenciar maiúsculas nem acentos).
+ */
+int format_SearchTitles(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 21: imprime os livros cujo título ou autor contém todos os termos.
+ *
+ * Valida a quantidade em @p idUser1 e a busca e chama:
+ *   PrintTermSearch(text, idUser1);
+ *
+ * @param userList   Ignorado.
+ * @param idUser1    Quantidade máxima de livros (N > 0).
+ * @param idBook     Ignorado (deve ser 0).
+ * @param idUser2    Ignorado (deve ser 0).
+ * @param text       Termos da busca (sem diferenciar maiúsculas nem acentos).
+ */
+int format_SearchTerms(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 22: conta os livros lidos por um usuário publicados num intervalo de anos.
+ *
+ * Valida existência de @p idUser1 e o intervalo e chama:
+ *   PrintYearCountUser(user, idBook, idUser2);
+ *
+ * @param userList   Lista de usuários.
+ * @param idUser1    ID do usuário consultado.
+ * @param idBook     Primeiro ano (inclusive).
+ * @param idUser2    Último ano (inclusive).
+ */
+int format_CountYearsUser(COMMAND_PARAMS);
+
+/**
+ * @brief Comando 23: imprime os livros do catálogo publicados num intervalo de anos.
+ *
+ * Valida o intervalo e a quantidade e chama:
+ *   PrintRangeYearIndex(idUser1, idBook, idUser2);
+ *
+ * @param userList   Ignorado.
+ * @param idUser1    Primeiro ano (inclusive).
+ * @param idBook     Último ano (inclusive).
+ * @param idUser2    Quantidade máxima de livros (N > 0).
+ */
+int format_PrintBooksByYear(COMMAND_PARAMS);
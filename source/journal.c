@@ -0,0 +1,210 @@
+/**
+ * @file journal.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the append-only journal of applied mutations.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "journal.h"
+#include "command.h"
+#include "utils.h"
+
+struct journal
+{
+    FILE *file;
+    int groupSize;
+    long windowNs;
+    int pending;
+    struct timespec oldestPending;
+
+    // A janela vale mesmo sem novos comandos: uma thread sincroniza o grupo
+    // quando ele vence. A trava protege o arquivo e os campos acima.
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t flusher;
+    int hasFlusher;
+    int closing;
+};
+
+static long ElapsedNs(struct timespec *since)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (now.tv_sec - since->tv_sec) * 1000000000L + (now.tv_nsec - since->tv_nsec);
+}
+
+static void CommitLocked(Journal *journal)
+{
+    if (!journal->pending)
+        return;
+
+    fflush(journal->file);
+    fsync(fileno(journal->file));
+    journal->pending = 0;
+}
+
+static void *FlushLoop(void *context)
+{
+    Journal *journal = context;
+    pthread_mutex_lock(&journal->lock);
+
+    while (!journal->closing)
+    {
+        if (!journal->pending)
+        {
+            pthread_cond_wait(&journal->wake, &journal->lock);
+            continue;
+        }
+
+        struct timespec deadline = journal->oldestPending;
+        deadline.tv_sec += journal->windowNs / 1000000000L;
+        deadline.tv_nsec += journal->windowNs % 1000000000L;
+
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        if (ElapsedNs(&journal->oldestPending) >= journal->windowNs)
+            CommitLocked(journal);
+        else
+            pthread_cond_timedwait(&journal->wake, &journal->lock, &deadline);
+    }
+
+    pthread_mutex_unlock(&journal->lock);
+
+    return NULL;
+}
+
+Journal *OpenJournal(char *path, int groupSize, int windowMs)
+{
+    assert(path);
+    Journal *journal = malloc(sizeof(Journal));
+    assert(journal);
+    journal->file = fopen(path, "a+");
+    assert(journal->file);
+    journal->groupSize = groupSize;
+    journal->windowNs = windowMs * 1000000L;
+    journal->pending = 0;
+    journal->closing = 0;
+
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&journal->wake, &attributes);
+    pthread_condattr_destroy(&attributes);
+    pthread_mutex_init(&journal->lock, NULL);
+
+    // Só grupos de mais de um registro ficam pendentes.
+    journal->hasFlusher = groupSize > 1 && pthread_create(&journal->flusher, NULL, FlushLoop, journal) == 0;
+
+    return journal;
+}
+
+Journal *OpenJournalFromEnv(void)
+{
+    char *path = getenv(JOURNAL_PATH_ENV);
+
+    if (!path || !*path)
+        return NULL;
+
+    char *group = getenv(JOURNAL_GROUP_ENV);
+    char *window = getenv(JOURNAL_WINDOW_ENV);
+
+    return OpenJournal(path,
+                       group ? atoi(group) : JOURNAL_DEFAULT_GROUP,
+                       window ? atoi(window) : JOURNAL_DEFAULT_WINDOW_MS);
+}
+
+int ReplayJournal(Journal *journal, List *userList)
+{
+    assert(journal);
+    char line[MAX_LINE_LENGTH] = "";
+    long validEnd = 0;
+    int replayed = 0;
+
+    rewind(journal->file);
+
+    while (fgets(line, sizeof(line), journal->file))
+    {
+        int op = 0, idUser1 = 0, idBook = 0, idUser2 = 0;
+        int complete = line[0] && line[strcspn(line, "\n")] == '\n';
+
+        if (!complete || sscanf(line, "%d;%d;%d;%d", &op, &idUser1, &idBook, &idUser2) != 4)
+            break; // registro interrompido no meio da gravação
+
+        ReplayCommand(userList, op, idUser1, idBook, idUser2);
+        validEnd = ftell(journal->file);
+        replayed++;
+    }
+
+    if (!feof(journal->file) || ftell(journal->file) != validEnd)
+    {
+        fflush(journal->file);
+        int truncated = ftruncate(fileno(journal->file), validEnd);
+        assert(truncated == 0);
+    }
+
+    fseek(journal->file, 0, SEEK_END);
+
+    return replayed;
+}
+
+void AppendJournal(Journal *journal, int op, int idUser1, int idBook, int idUser2)
+{
+    assert(journal);
+    pthread_mutex_lock(&journal->lock);
+    fprintf(journal->file, "%d;%d;%d;%d\n", op, idUser1, idBook, idUser2);
+
+    if (!journal->pending++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &journal->oldestPending);
+        pthread_cond_signal(&journal->wake);
+    }
+
+    if (journal->pending >= journal->groupSize || ElapsedNs(&journal->oldestPending) >= journal->windowNs)
+        CommitLocked(journal);
+
+    pthread_mutex_unlock(&journal->lock);
+}
+
+void CommitJournal(Journal *journal)
+{
+    assert(journal);
+    pthread_mutex_lock(&journal->lock);
+    CommitLocked(journal);
+    pthread_mutex_unlock(&journal->lock);
+}
+
+void CloseJournal(Journal *journal)
+{
+    assert(journal);
+
+    if (journal->hasFlusher)
+    {
+        pthread_mutex_lock(&journal->lock);
+        journal->closing = 1;
+        pthread_cond_signal(&journal->wake);
+        pthread_mutex_unlock(&journal->lock);
+        pthread_join(journal->flusher, NULL);
+    }
+
+    CommitJournal(journal);
+    fclose(journal->file);
+    pthread_cond_destroy(&journal->wake);
+    pthread_mutex_destroy(&journal->lock);
+    free(journal);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file journal.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the append-only journal of applied mutations.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "list.h"
+
+/**
+ * @def JOURNAL_PATH_ENV
+ * @brief Variável de ambiente com o caminho do journal.
+ *
+ * Se não estiver definida, o journal fica desligado e o programa
+ * se comporta exatamente como antes.
+ */
+#define JOURNAL_PATH_ENV "BOOKED_JOURNAL"
+
+/**
+ * @def JOURNAL_GROUP_ENV
+ * @brief Variável de ambiente com a quantidade de registros por fsync.
+ *
+ * Valores <= 1 sincronizam cada registro individualmente.
+ */
+#define JOURNAL_GROUP_ENV "BOOKED_JOURNAL_GROUP"
+
+/**
+ * @def JOURNAL_WINDOW_ENV
+ * @brief Variável de ambiente com a janela máxima (ms) de um grupo pendente.
+ */
+#define JOURNAL_WINDOW_ENV "BOOKED_JOURNAL_WINDOW_MS"
+
+/**
+ * @brief Quantidade padrão de registros agrupados em um único fsync.
+ */
+#define JOURNAL_DEFAULT_GROUP 64
+
+/**
+ * @brief Janela padrão (ms) antes de forçar o fsync de um grupo incompleto.
+ */
+#define JOURNAL_DEFAULT_WINDOW_MS 10
+
+/**
+ * @brief Tipo opaco que representa o journal de mutações.
+ *
+ * Cada registro tem o mesmo formato de uma linha de comandos.txt:
+ *   op;idUser1;idBook;idUser2
+ * e só é gravado quando o comando alterou o estado.
+ */
+typedef struct journal Journal;
+
+/**
+ * @brief Abre (ou cria) um journal.
+ *
+ * Os registros são acumulados e sincronizados em grupo (group commit):
+ * o fsync acontece quando @p groupSize registros estão pendentes ou
+ * quando o mais antigo deles passou de @p windowMs milissegundos. Com
+ * grupos de mais de um registro, uma thread do journal faz esse fsync
+ * mesmo que nenhum outro comando chegue.
+ *
+ * @param path      Caminho do arquivo de journal.
+ * @param groupSize Registros por fsync (<= 1 sincroniza cada registro).
+ * @param windowMs  Latência máxima de um grupo pendente, em ms.
+ * @return Ponteiro para o Journal aberto.
+ */
+Journal *OpenJournal(char *path, int groupSize, int windowMs);
+
+/**
+ * @brief Abre o journal configurado pelas variáveis de ambiente.
+ *
+ * @return Ponteiro para o Journal, ou NULL se JOURNAL_PATH_ENV não estiver definida.
+ */
+Journal *OpenJournalFromEnv(void);
+
+/**
+ * @brief Reaplica todos os registros do journal sobre os dados carregados.
+ *
+ * Não imprime nada. Um registro final incompleto (gravação interrompida)
+ * é descartado e o arquivo é truncado no último registro válido.
+ *
+ * @param journal  Ponteiro para o Journal.
+ * @param userList Lista de usuários já carregada.
+ * @return Quantidade de registros reaplicados.
+ */
+int ReplayJournal(Journal *journal, List *userList);
+
+/**
+ * @brief Acrescenta uma mutação aplicada ao journal.
+ *
+ * @param journal Ponteiro para o Journal.
+ * @param op      Código do comando (1 a 5).
+ * @param idUser1 Primeiro ID de usuário do comando.
+ * @param idBook  ID do livro do comando.
+ * @param idUser2 Segundo ID de usuário do comando.
+ */
+void AppendJournal(Journal *journal, int op, int idUser1, int idBook, int idUser2);
+
+/**
+ * @brief Força o fsync dos registros pendentes.
+ *
+ * @param journal Ponteiro para o Journal.
+ */
+void CommitJournal(Journal *journal);
+
+/**
+ * @brief Sincroniza o que estiver pendente, fecha o arquivo e libera o Journal.
+ *
+ * @param journal Ponteiro para o Journal.
+ */
+void CloseJournal(Journal *journal);
@@ -11,32 +11,58 @@
 
 #include "list.h"
 #include "cell.h"
+#include "memory.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <assert.h>
 
-struct list
-{
-    Cell *first;
-    Cell *last;
-    print_fn print_fn;
-    compare_key_fn compare_key_fn;
-};
-
 int IsEmptyList(List *list)
 {
     assert(list);
     return !list->first;
 }
 
-List *CreateList(print_fn print_fn, compare_key_fn compare_key_fn)
+void InitList(List *list, print_fn print_fn, compare_key_fn compare_key_fn)
 {
-    List *list = malloc(sizeof(List));
     assert(list);
     list->first = list->last = NULL;
+    list->length = 0;
+    list->memoryTag = MEMORY_CELL;
     list->print_fn = print_fn;
     list->compare_key_fn = compare_key_fn;
+}
+
+List *CreateList(print_fn print_fn, compare_key_fn compare_key_fn)
+{
+    List *list = AllocMemory(MEMORY_LIST, sizeof(List));
+    InitList(list, print_fn, compare_key_fn);
+
+    return list;
+}
+
+void SetMemoryTagList(List *list, int tag)
+{
+    assert(list);
+    assert(!list->first);
+    list->memoryTag = tag;
+}
+
+void InitCopyList(List *copy, List *list, int tag)
+{
+    assert(list);
+    InitList(copy, list->print_fn, list->compare_key_fn);
+    copy->memoryTag = tag;
+
+    for (Cell *cur = list->first; cur; cur = GetNext(cur))
+        AppendList(copy, GetValue(cur));
+}
+
+List *CreateScratchList(print_fn print_fn, compare_key_fn compare_key_fn)
+{
+    List *list = AllocMemory(MEMORY_SCRATCH, sizeof(List));
+    InitList(list, print_fn, compare_key_fn);
+    list->memoryTag = MEMORY_SCRATCH;
 
     return list;
 }
@@ -44,7 +70,8 @@ List *CreateList(print_fn print_fn, compare_key_fn compare_key_fn)
 void AppendList(List *list, void *value)
 {
     assert(list);
-    Cell *cell = CreateCell(value);
+    Cell *cell = CreateCell(value, list->memoryTag);
+    list->length++;
 
     if (IsEmptyList(list))
     {
@@ -56,81 +83,135 @@ void AppendList(List *list, void *value)
     list->last = cell;
 }
 
-void RemoveList(List *list, ...)
+/**
+ * @brief Avança @p cursor até o primeiro elemento que casa com @p keys_list.
+ */
+static void SeekCursor(ListCursor *cursor, va_list keys_list)
 {
-    assert(list);
-    Cell *prev = NULL;
-    Cell *cur = list->first;
-    va_list keys_list;
-    va_start(keys_list, list);
-
-    while (cur)
+    while (cursor->cur)
     {
         va_list keys_copy;
         va_copy(keys_copy, keys_list);
+        int found = cursor->list->compare_key_fn(GetValue(cursor->cur), keys_copy);
+        va_end(keys_copy);
 
-        if (list->compare_key_fn(GetValue(cur), keys_copy))
-        {
-            va_end(keys_copy);
-            va_end(keys_list);
-            break;
-        }
+        if (found)
+            return;
 
-        va_end(keys_copy);
-        prev = cur;
-        cur = GetNext(cur);
+        NextCursor(cursor);
     }
+}
+
+ListCursor BeginList(List *list)
+{
+    assert(list);
+    ListCursor cursor = {list, NULL, list->first};
+
+    return cursor;
+}
 
+ListCursor SeekList(List *list, ...)
+{
+    ListCursor cursor = BeginList(list);
+    va_list keys_list;
+    va_start(keys_list, list);
+    SeekCursor(&cursor, keys_list);
     va_end(keys_list);
 
-    if (!cur)
-        return; // not found
+    return cursor;
+}
 
-    if (cur == list->first)
-    {
-        list->first = GetNext(cur);
-        FreeCell(cur);
-        return;
-    } // first element
+int IsEndCursor(ListCursor *cursor)
+{
+    assert(cursor);
+    return !cursor->cur;
+}
 
-    if (cur == list->last)
+void NextCursor(ListCursor *cursor)
+{
+    assert(cursor);
+    assert(cursor->cur);
+    cursor->prev = cursor->cur;
+    cursor->cur = GetNext(cursor->cur);
+}
+
+void *GetValueCursor(ListCursor *cursor)
+{
+    assert(cursor);
+    return GetValue(cursor->cur);
+}
+
+void *EraseCursor(ListCursor *cursor)
+{
+    assert(cursor);
+    assert(cursor->cur);
+    List *list = cursor->list;
+    Cell *erased = cursor->cur;
+    void *value = GetValue(erased);
+    cursor->cur = GetNext(erased);
+
+    if (cursor->prev)
+        SetNext(cursor->prev, cursor->cur);
+    else
+        list->first = cursor->cur;
+
+    if (list->last == erased)
+        list->last = cursor->prev;
+
+    FreeCell(erased, list->memoryTag);
+    list->length--;
+
+    return value;
+}
+
+void InsertAfterCursor(ListCursor *cursor, void *value)
+{
+    assert(cursor);
+    List *list = cursor->list;
+
+    if (!cursor->cur)
     {
-        list->last = prev;
-        SetNext(prev, NULL);
-        FreeCell(cur);
+        AppendList(list, value);
+        cursor->prev = list->last; // o cursor continua no fim, agora após o novo elemento
         return;
-    } // last element
+    }
 
-    SetNext(prev, GetNext(cur));
-    FreeCell(cur); // middle element
+    Cell *cell = CreateCell(value, list->memoryTag);
+    SetNext(cell, GetNext(cursor->cur));
+    SetNext(cursor->cur, cell);
+    list->length++;
+
+    if (list->last == cursor->cur)
+        list->last = cell;
 }
 
-void *FindList(List *list, ...)
+void RemoveList(List *list, ...)
 {
-    assert(list);
-    Cell *cur = list->first;
+    ListCursor cursor = BeginList(list);
     va_list keys_list;
     va_start(keys_list, list);
+    SeekCursor(&cursor, keys_list);
+    va_end(keys_list);
 
-    while (cur)
-    {
-        va_list keys_copy;
-        va_copy(keys_copy, keys_list);
-
-        if (list->compare_key_fn(GetValue(cur), keys_copy))
-        {
-            va_end(keys_copy);
-            va_end(keys_list);
-            return GetValue(cur);
-        }
-
-        va_end(keys_copy);
-        cur = GetNext(cur);
-    }
+    if (!IsEndCursor(&cursor))
+        EraseCursor(&cursor);
+}
 
+void *FindList(List *list, ...)
+{
+    ListCursor cursor = BeginList(list);
+    va_list keys_list;
+    va_start(keys_list, list);
+    SeekCursor(&cursor, keys_list);
     va_end(keys_list);
 
-    return NULL;
+    return IsEndCursor(&cursor) ? NULL : GetValueCursor(&cursor);
+}
+
+int GetLengthList(List *list)
+{
+    assert(list);
+    return list->length;
 }
 
 void *GetFirstList(List *list)
@@ -171,11 +252,17 @@ void PrintList(List *list)
     }
 }
 
+void ReleaseList(List *list)
+{
+    ClearList(list);
+}
+
 void FreeList(List *list)
 {
     assert(list);
-    ClearList(list);
-    free(list);
+    int tag = list->memoryTag == MEMORY_SCRATCH ? MEMORY_SCRATCH : MEMORY_LIST;
+    ReleaseList(list);
+    FreeMemory(tag, list, sizeof(List));
 }
 
 void ClearList(List *list)
@@ -188,10 +275,11 @@ void ClearList(List *list)
     {
         prev = cur;
         cur = GetNext(cur);
-        FreeCell(prev);
+        FreeCell(prev, list->memoryTag);
     }
 
-    list->first = NULL;
+    list->first = list->last = NULL;
+    list->length = 0;
 }
 
 void IterList(List *list, iter_fn iter_fn)
@@ -231,23 +319,18 @@ List *GetCommonItemsList(List *list1, List *list2, compare_key_fn compareKey, pr
 {
     assert(list1);
     assert(list2);
-    List *commonItems = CreateList(print, compareKey);
+    List *commonItems = CreateScratchList(print, compareKey);
 
-    Cell *c1 = list1->first;
-    Cell *c2 = NULL;
-    while (c1 != NULL)
+    for (ListCursor c1 = BeginList(list1); !IsEndCursor(&c1); NextCursor(&c1))
     {
-        c2 = list2->first;
-        while (c2 != NULL)
-        {
-            if (compareItems(GetValue(c1), GetValue(c2)))
-            {
-                AppendList(commonItems, GetValue(c1));
-                break;
-            }
-            c2 = GetNext(c2);
-        }
-        c1 = GetNext(c1);
+        void *item = GetValueCursor(&c1);
+        ListCursor c2 = BeginList(list2);
+
+        while (!IsEndCursor(&c2) && !compareItems(item, GetValueCursor(&c2)))
+            NextCursor(&c2);
+
+        if (!IsEndCursor(&c2))
+            AppendList(commonItems, item);
     }
 
     return commonItems;
@@ -15,10 +15,38 @@
 #include "cell.h"
 
 /**
- * @brief Tipo opaco que representa uma lista encadeada.
+ * @brief Lista encadeada.
+ *
+ * Os campos são expostos só para que o cabeçalho possa ser embutido em
+ * outras structs (ver InitList); use sempre as funções abaixo.
  */
 typedef struct list List;
 
+struct list
+{
+    Cell *first;
+    Cell *last;
+    int length;
+    int memoryTag; // subsistema ao qual as células são contabilizadas
+    print_fn print_fn;
+    compare_key_fn compare_key_fn;
+};
+
+/**
+ * @brief Cursor sobre uma lista encadeada.
+ *
+ * Guarda a célula atual e a anterior, de modo que remover ou inserir na
+ * posição do cursor custa O(1), sem percorrer a lista de novo. Os campos
+ * são expostos só para o cursor poder viver na pilha: use as funções
+ * *Cursor para manipulá-lo.
+ */
+typedef struct
+{
+    List *list;
+    Cell *prev; // célula anterior à atual (NULL se a atual é a primeira)
+    Cell *cur;  // célula atual (NULL quando o cursor passou do fim)
+} ListCursor;
+
 /**
  * @brief Cria uma nova lista encadeada.
  *
@@ -28,6 +56,58 @@ typedef struct list List;
  */
 List *CreateList(print_fn print_fn, compare_key_fn compare_key_fn);
 
+/**
+ * @brief Cria uma lista de rascunho, que vive só até o fim do comando atual.
+ *
+ * Cabeçalho e células saem da arena de rascunho (MEMORY_SCRATCH), que é
+ * rebobinada depois de cada comando; FreeList nela é opcional e barato.
+ *
+ * @param print_fn          Função de impressão dos elementos.
+ * @param compare_key_fn    Função para comparar elementos com chaves.
+ * @return Ponteiro para a nova List criada.
+ */
+List *CreateScratchList(print_fn print_fn, compare_key_fn compare_key_fn);
+
+/**
+ * @brief Inicializa uma lista vazia num cabeçalho já reservado (ex.: embutido em outra struct).
+ *
+ * Uma lista inicializada assim é desfeita com ReleaseList, não FreeList.
+ *
+ * @param list              Cabeçalho a ser inicializado.
+ * @param print_fn          Função de impressão dos elementos.
+ * @param compare_key_fn    Função para comparar elementos com chaves.
+ */
+void InitList(List *list, print_fn print_fn, compare_key_fn compare_key_fn);
+
+/**
+ * @brief Inicializa @p copy como cópia rasa de @p list.
+ *
+ * A cópia tem as mesmas funções de impressão/comparação e aponta para os
+ * mesmos elementos, na mesma ordem; só as células são novas.
+ *
+ * @param copy Cabeçalho já reservado a ser inicializado.
+ * @param list Lista a ser copiada.
+ * @param tag  Subsistema (MEMORY_*) das células da cópia.
+ */
+void InitCopyList(List *copy, List *list, int tag);
+
+/**
+ * @brief Libera as células de uma lista criada com InitList, sem liberar o cabeçalho.
+ *
+ * @param list Ponteiro para a lista.
+ */
+void ReleaseList(List *list);
+
+/**
+ * @brief Define o subsistema (MEMORY_*) ao qual as células da lista são contabilizadas.
+ *
+ * Deve ser chamada com a lista ainda vazia; o padrão é MEMORY_CELL.
+ *
+ * @param list Lista vazia.
+ * @param tag  Uma das constantes MEMORY_*.
+ */
+void SetMemoryTagList(List *list, int tag);
+
 /**
  * @brief Verifica se a lista está vazia.
  *
@@ -61,6 +141,14 @@ void RemoveList(List *list, ...);
  */
 void *FindList(List *list, ...);
 
+/**
+ * @brief Retorna a quantidade de elementos da lista, em O(1).
+ *
+ * @param list Lista alvo.
+ * @return Quantidade de elementos.
+ */
+int GetLengthList(List *list);
+
 /**
  * @brief Retorna o primeiro elemento da lista.
  *
@@ -85,6 +173,68 @@ void *GetLastList(List *list);
  */
 Cell *GetFirstCellList(List *list);
 
+/**
+ * @brief Posiciona um cursor no primeiro elemento da lista.
+ *
+ * @param list Lista alvo.
+ * @return Cursor no início (já no fim se a lista estiver vazia).
+ */
+ListCursor BeginList(List *list);
+
+/**
+ * @brief Posiciona um cursor no primeiro elemento que casa com as chaves.
+ *
+ * @param list Lista onde realizar a busca.
+ * @param ...  Chaves para busca.
+ * @return Cursor no elemento encontrado, ou no fim se não encontrado.
+ */
+ListCursor SeekList(List *list, ...);
+
+/**
+ * @brief Verifica se o cursor passou do último elemento.
+ *
+ * @param cursor Ponteiro para o cursor.
+ * @return 1 se está no fim, 0 caso contrário.
+ */
+int IsEndCursor(ListCursor *cursor);
+
+/**
+ * @brief Avança o cursor para o próximo elemento.
+ *
+ * @param cursor Ponteiro para o cursor (não pode estar no fim).
+ */
+void NextCursor(ListCursor *cursor);
+
+/**
+ * @brief Retorna o elemento na posição do cursor.
+ *
+ * @param cursor Ponteiro para o cursor (não pode estar no fim).
+ * @return Ponteiro para o elemento atual.
+ */
+void *GetValueCursor(ListCursor *cursor);
+
+/**
+ * @brief Remove o elemento na posição do cursor em O(1).
+ *
+ * O cursor passa a apontar para o elemento seguinte, então é seguro
+ * remover durante um percurso.
+ *
+ * @param cursor Ponteiro para o cursor (não pode estar no fim).
+ * @return Ponteiro para o elemento removido (não é liberado).
+ */
+void *EraseCursor(ListCursor *cursor);
+
+/**
+ * @brief Insere um elemento logo após a posição do cursor em O(1).
+ *
+ * Se o cursor estiver no fim, o elemento vai para o final da lista.
+ * O cursor continua no mesmo elemento.
+ *
+ * @param cursor Ponteiro para o cursor.
+ * @param value  Ponteiro para o dado a ser inserido.
+ */
+void InsertAfterCursor(ListCursor *cursor, void *value);
+
 /**
  * @brief Imprime todos os elementos da lista.
  *
@@ -129,6 +279,8 @@ void ForEach(List *list, for_each_fn for_each_fn);
 /**
  * @brief Retorna uma nova lista com os elementos comuns entre duas listas.
  *
+ * A lista é de rascunho (ver CreateScratchList): só vale até o fim do comando.
+ *
  * @param list1         Primeira lista.
  * @param list2         Segunda lista.
  * @param compare       Função para comparar elementos por chave.
@@ -2,12 +2,19 @@
 #include "book.h"
 #include "user.h"
 #include "command.h"
+#include "journal.h"
+#include "recommendation.h"
+#include "metrics.h"
+#include "memory.h"
+#include "threadpool.h"
+#include "search.h"
 #include <stdio.h>
 #include <stdlib.h>
 
 int main(int argc, char const *argv[])
 {
-    List *bookList = CreateList(PrintBook, CompareIdBook);
+    InitArenasMemory();
+    InitMetrics();
     List *userList = CreateList(PrintUser, CompareIdUser);
     FILE *bookFile = NULL;
     FILE *userFile = NULL;
@@ -36,34 +43,80 @@ int main(int argc, char const *argv[])
     fscanf(commandFile, "%*[^\n]\n");
     fscanf(userFile, "%*[^\n]\n");
 
-    Book *book = NULL;
     User *user = NULL;
+    Probe start = StartProbeMetrics();
 
-    while ((book = ReadBook(bookFile)))
+    if (IsLazyBooks())
     {
-        AppendList(bookList, book);
+        MapBooks(bookFile);
+    }
+    else
+    {
+        while (ReadBook(bookFile))
+            ;
     }
 
     fclose(bookFile);
+    RecordPhaseMetrics(PHASE_LOAD_BOOKS, &start);
+
+    // No modo preguiçoso os índices de busca esperam a primeira consulta, para não decodificar tudo.
+    if (!IsLazyBooks())
+    {
+        start = StartProbeMetrics();
+        LoadIndexSearch();
+        RecordPhaseMetrics(PHASE_BUILD_SEARCH, &start);
+        ResetScratchMemory();
+    }
+
+    start = StartProbeMetrics();
+    int userCount = 0;
 
     while ((user = ReadUser(userFile)))
     {
+        SetIndexUser(user, userCount++);
         AppendList(userList, user);
     }
 
     fclose(userFile);
-    IterList(userList, ConnectUsers);
+    RecordPhaseMetrics(PHASE_LOAD_USERS, &start);
+
+    // O grafo de afinidades é construído sob demanda (ver EnsureAffinityGraph).
 
-    while (ExecuteCommand(commandFile, userList, bookList))
+    // Reaplica as mutações de execuções anteriores, se o journal estiver ligado.
+    Journal *journal = OpenJournalFromEnv();
+
+    if (journal)
+    {
+        start = StartProbeMetrics();
+        ReplayJournal(journal, userList);
+        RecordPhaseMetrics(PHASE_REPLAY_JOURNAL, &start);
+    }
+
+    start = StartProbeMetrics();
+
+    while (ExecuteCommand(commandFile, userList, journal))
         ;
 
+    RecordPhaseMetrics(PHASE_COMMANDS, &start);
+
     fclose(commandFile);
 
-    ForEach(bookList, FreeBook);
-    ForEach(userList, FreeUser);
+    if (journal)
+        CloseJournal(journal);
+
+    // O relatório sai antes da liberação: depois dela a memória viva é zero.
+    ReportMetrics();
 
-    FreeList(bookList);
-    FreeList(userList);
+    // Leitores, livros, listas e recomendações vivem nas arenas: em vez de
+    // liberar cada objeto, os módulos só esquecem seus blocos e as arenas
+    // voltam ao sistema com um munmap por bloco.
+    FreeSharedThreadPool();
+    FreeStoreUsers();
+    FreeIndexSearch();
+    FreeCatalogBooks();
+    FreeRecommendationPool();
+    FreeCellPools();
+    FreeArenasMemory();
 
     return 0;
 }
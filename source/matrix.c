@@ -0,0 +1,288 @@
+/**
+ * @file matrix.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the batch shared-reading matrix over affinity pairs.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "matrix.h"
+#include "user.h"
+#include "book.h"
+#include "bookindex.h"
+#include "threadpool.h"
+#include "memory.h"
+
+/**
+ * @brief Leitores (linhas) por tarefa do pool.
+ */
+#define MATRIX_ROWS_PER_TASK 32
+
+/**
+ * @brief Palavras de 64 bits por bloco de colunas (2 KiB por linha).
+ */
+#define MATRIX_WORDS_PER_BLOCK 256
+
+#define WORD_BITS 64
+
+typedef struct
+{
+    int userCount;
+    int words;
+    unsigned long **rows; // bitset de cada leitor; NULL se ele não leu nada (ou no modo esparso)
+    int *rowStart;        // modo esparso: colunas de u em columns[rowStart[u]..rowStart[u + 1]), em ordem
+    int *columns;
+    int *edgeStart;       // arestas (u, v) com u < v, agrupadas por u
+    int *edgeTarget;
+    int *shared;          // resultado de cada aresta
+} Matrix;
+
+typedef struct
+{
+    int *columnOf;
+    unsigned long *row;
+} FillContext;
+
+static void SetBit(Book *book, void *context)
+{
+    FillContext *fill = context;
+    int column = fill->columnOf[GetIndexBook(book)];
+    fill->row[column / WORD_BITS] |= 1UL << (column % WORD_BITS);
+}
+
+typedef struct
+{
+    int *columnOf;
+    int *next;
+} ListContext;
+
+static void AppendColumn(Book *book, void *context)
+{
+    ListContext *list = context;
+    *list->next++ = list->columnOf[GetIndexBook(book)];
+}
+
+static int CompareColumns(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+static void CountTask(int task, void *context)
+{
+    Matrix *matrix = context;
+    int first = task * MATRIX_ROWS_PER_TASK;
+    int last = first + MATRIX_ROWS_PER_TASK < matrix->userCount ? first + MATRIX_ROWS_PER_TASK : matrix->userCount;
+
+    for (int block = 0; block < matrix->words; block += MATRIX_WORDS_PER_BLOCK)
+    {
+        int end = block + MATRIX_WORDS_PER_BLOCK < matrix->words ? block + MATRIX_WORDS_PER_BLOCK : matrix->words;
+
+        for (int u = first; u < last; u++)
+        {
+            unsigned long *row = matrix->rows[u];
+
+            if (!row)
+                continue;
+
+            for (int e = matrix->edgeStart[u]; e < matrix->edgeStart[u + 1]; e++)
+            {
+                unsigned long *other = matrix->rows[matrix->edgeTarget[e]];
+
+                if (!other)
+                    continue;
+
+                int shared = 0;
+
+                for (int w = block; w < end; w++)
+                    shared += __builtin_popcountl(row[w] & other[w]);
+
+                matrix->shared[e] += shared;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Como CountTask, mas cruzando as listas ordenadas de colunas (modo esparso).
+ */
+static void CountSparseTask(int task, void *context)
+{
+    Matrix *matrix = context;
+    int first = task * MATRIX_ROWS_PER_TASK;
+    int last = first + MATRIX_ROWS_PER_TASK < matrix->userCount ? first + MATRIX_ROWS_PER_TASK : matrix->userCount;
+
+    for (int u = first; u < last; u++)
+    {
+        for (int e = matrix->edgeStart[u]; e < matrix->edgeStart[u + 1]; e++)
+        {
+            int v = matrix->edgeTarget[e];
+            int i = matrix->rowStart[u];
+            int j = matrix->rowStart[v];
+            int shared = 0;
+
+            while (i < matrix->rowStart[u + 1] && j < matrix->rowStart[v + 1])
+            {
+                int a = matrix->columns[i];
+                int b = matrix->columns[j];
+                shared += a == b;
+                i += a <= b;
+                j += b <= a;
+            }
+
+            matrix->shared[e] = shared;
+        }
+    }
+}
+
+/**
+ * @brief Limite, em bytes, das linhas densas (ver MATRIX_DENSE_ENV).
+ */
+static size_t DenseLimit(void)
+{
+    char *limit = getenv(MATRIX_DENSE_ENV);
+
+    return (size_t)(limit && *limit ? atol(limit) : MATRIX_DEFAULT_DENSE_KB) * 1024;
+}
+
+long WriteSharedMatrix(List *userList, FILE *out)
+{
+    assert(userList);
+    assert(out);
+    Matrix matrix = {0};
+    matrix.userCount = GetLengthList(userList);
+    int n = matrix.userCount;
+
+    // Tudo é reservado aqui, antes do pool: as tarefas só leem e somam.
+    User **users = AllocMemory(MEMORY_SCRATCH, n * sizeof(User *));
+
+    for (ListCursor cursor = BeginList(userList); !IsEndCursor(&cursor); NextCursor(&cursor))
+    {
+        User *user = GetValueCursor(&cursor);
+        assert(GetIndexUser(user) >= 0 && GetIndexUser(user) < n);
+        users[GetIndexUser(user)] = user;
+    }
+
+    int bookCount = GetCountBooks();
+    int *columnOf = AllocMemory(MEMORY_SCRATCH, bookCount * sizeof(int));
+    int columns = 0;
+
+    for (int b = 0; b < bookCount; b++)
+        columnOf[b] = GetCountBookIndex(BOOKINDEX_READERS, b) ? columns++ : -1;
+
+    matrix.words = (columns + WORD_BITS - 1) / WORD_BITS;
+    int nonEmpty = 0;
+    long reads = 0;
+
+    for (int u = 0; u < n; u++)
+    {
+        int length = GetLengthBookSet(GetFinishedBooksUser(users[u]));
+        nonEmpty += length > 0;
+        reads += length;
+    }
+
+    size_t denseWords = (size_t)nonEmpty * matrix.words;
+    unsigned long *bits = NULL;
+    int dense = denseWords * sizeof(unsigned long) <= DenseLimit();
+
+    if (dense)
+    {
+        matrix.rows = CallocMemory(MEMORY_SCRATCH, n, sizeof(unsigned long *));
+        bits = CallocMemory(MEMORY_SCRATCH, denseWords, sizeof(unsigned long));
+        unsigned long *next = bits;
+
+        for (int u = 0; u < n; u++)
+        {
+            BookSet *finished = GetFinishedBooksUser(users[u]);
+
+            if (!GetLengthBookSet(finished))
+                continue;
+
+            FillContext fill = {columnOf, next};
+            ForEachBookSet(finished, SetBit, &fill);
+            matrix.rows[u] = next;
+            next += matrix.words;
+        }
+    }
+    else
+    {
+        // Esparso: memória proporcional às leituras, não a leitores x livros.
+        matrix.rowStart = AllocMemory(MEMORY_SCRATCH, (n + 1) * sizeof(int));
+        matrix.columns = AllocMemory(MEMORY_SCRATCH, reads * sizeof(int));
+        ListContext list = {columnOf, matrix.columns};
+
+        for (int u = 0; u < n; u++)
+        {
+            matrix.rowStart[u] = (int)(list.next - matrix.columns);
+            ForEachBookSet(GetFinishedBooksUser(users[u]), AppendColumn, &list);
+            qsort(matrix.columns + matrix.rowStart[u], list.next - matrix.columns - matrix.rowStart[u], sizeof(int), CompareColumns);
+        }
+
+        matrix.rowStart[n] = (int)reads;
+    }
+
+    matrix.edgeStart = AllocMemory(MEMORY_SCRATCH, (n + 1) * sizeof(int));
+    long edges = 0;
+
+    for (int u = 0; u < n; u++)
+    {
+        matrix.edgeStart[u] = (int)edges;
+
+        for (ListCursor cursor = BeginList(GetAfinitiesUser(users[u])); !IsEndCursor(&cursor); NextCursor(&cursor))
+            edges += GetIndexUser(GetValueCursor(&cursor)) > u;
+    }
+
+    matrix.edgeStart[n] = (int)edges;
+    matrix.edgeTarget = AllocMemory(MEMORY_SCRATCH, edges * sizeof(int));
+    matrix.shared = CallocMemory(MEMORY_SCRATCH, edges, sizeof(int));
+
+    for (int u = 0; u < n; u++)
+    {
+        int e = matrix.edgeStart[u];
+
+        for (ListCursor cursor = BeginList(GetAfinitiesUser(users[u])); !IsEndCursor(&cursor); NextCursor(&cursor))
+        {
+            int v = GetIndexUser(GetValueCursor(&cursor));
+
+            if (v > u)
+                matrix.edgeTarget[e++] = v;
+        }
+    }
+
+    if (matrix.words)
+        RunThreadPool(GetSharedThreadPool(), dense ? CountTask : CountSparseTask,
+                      (n + MATRIX_ROWS_PER_TASK - 1) / MATRIX_ROWS_PER_TASK, &matrix);
+
+    fprintf(out, "leitor1;leitor2;comum\n");
+
+    for (int u = 0; u < n; u++)
+    {
+        for (int e = matrix.edgeStart[u]; e < matrix.edgeStart[u + 1]; e++)
+            fprintf(out, "%d;%d;%d\n", GetIdUser(users[u]), GetIdUser(users[matrix.edgeTarget[e]]), matrix.shared[e]);
+    }
+
+    FreeMemory(MEMORY_SCRATCH, matrix.shared, edges * sizeof(int));
+    FreeMemory(MEMORY_SCRATCH, matrix.edgeTarget, edges * sizeof(int));
+    FreeMemory(MEMORY_SCRATCH, matrix.edgeStart, (n + 1) * sizeof(int));
+    if (dense)
+    {
+        FreeMemory(MEMORY_SCRATCH, bits, denseWords * sizeof(unsigned long));
+        FreeMemory(MEMORY_SCRATCH, matrix.rows, n * sizeof(unsigned long *));
+    }
+    else
+    {
+        FreeMemory(MEMORY_SCRATCH, matrix.columns, reads * sizeof(int));
+        FreeMemory(MEMORY_SCRATCH, matrix.rowStart, (n + 1) * sizeof(int));
+    }
+
+    FreeMemory(MEMORY_SCRATCH, columnOf, bookCount * sizeof(int));
+    FreeMemory(MEMORY_SCRATCH, users, n * sizeof(User *));
+
+    return edges;
+}
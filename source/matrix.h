@@ -0,0 +1,66 @@
+/**
+ * @file matrix.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the batch shared-reading matrix over affinity pairs.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include "list.h"
+
+/**
+ * @def MATRIX_DEFAULT_FILE
+ * @brief Arquivo gravado pelo comando 18 quando nenhum caminho é informado.
+ */
+#define MATRIX_DEFAULT_FILE "./compartilhados.csv"
+
+/**
+ * @def MATRIX_DENSE_ENV
+ * @brief Variável de ambiente com o limite, em KiB, das linhas densas do comando 18.
+ *
+ * As linhas densas custam leitores x livros lidos bits; acima do limite
+ * o comando usa listas ordenadas de colunas por leitor (ver
+ * WriteSharedMatrix). 0 força o modo esparso.
+ */
+#define MATRIX_DENSE_ENV "BOOKED_MATRIX_DENSE_KB"
+
+/**
+ * @brief Limite das linhas densas quando MATRIX_DENSE_ENV não é definida (16 MiB).
+ */
+#define MATRIX_DEFAULT_DENSE_KB 16384
+
+/**
+ * @brief Grava a quantidade de livros em comum de cada par de leitores com afinidade.
+ *
+ * Os livros lidos de cada leitor viram um bitset sobre as colunas dos
+ * livros que alguém leu (ver GetCountBookIndex), e cada par (aresta do
+ * grafo de afinidades) vira um popcount do AND das duas linhas. As
+ * linhas são divididas em tarefas de MATRIX_ROWS_PER_TASK leitores entre
+ * as threads do pool compartilhado (ver threadpool.h); dentro de uma
+ * tarefa, as colunas são percorridas em blocos de MATRIX_WORDS_PER_BLOCK
+ * palavras, para que o trecho de cada linha continue em cache enquanto
+ * é cruzado com todos os vizinhos.
+ *
+ * Se as linhas densas passarem de MATRIX_DENSE_ENV, cada leitor vira a
+ * lista ordenada das suas colunas (memória proporcional às leituras) e
+ * cada par é a interseção das duas listas, nas mesmas tarefas do pool.
+ *
+ * Formato (uma linha por par, o menor ID de posição primeiro):
+ * @verbatim
+ * leitor1;leitor2;comum
+ * 1;3;2
+ * @endverbatim
+ *
+ * O grafo de afinidades já deve estar construído.
+ *
+ * @param userList Lista de usuários (posições 0 a n - 1, ver SetIndexUser).
+ * @param out      Arquivo de saída aberto para escrita.
+ * @return Quantidade de pares gravados.
+ */
+long WriteSharedMatrix(List *userList, FILE *out);
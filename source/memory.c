@@ -0,0 +1,196 @@
+/**
+ * @file memory.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the allocation layer that accounts memory per subsystem.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "memory.h"
+#include "arena.h"
+
+static const char *tagNames[MEMORY_TAG_COUNT] = {
+    "cell",
+    "list",
+    "book",
+    "user",
+    "recommendation",
+    "affinity",
+    "scratch",
+    "index",
+    "snapshot",
+};
+
+// A última posição acumula o total, que tem pico próprio.
+static MemoryStats stats[MEMORY_TAG_COUNT + 1];
+static Arena *dataset = NULL;
+static Arena *scratch = NULL;
+
+static void RaisePeak(long *peak, long live)
+{
+    long seen = __atomic_load_n(peak, __ATOMIC_RELAXED);
+
+    while (live > seen && !__atomic_compare_exchange_n(peak, &seen, live, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+static void Charge(MemoryStats *target, long bytes)
+{
+    long live = __atomic_add_fetch(&target->liveBytes, bytes, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&target->allocations, 1, __ATOMIC_RELAXED);
+    RaisePeak(&target->peakBytes, live);
+}
+
+static void Discharge(MemoryStats *target, long bytes)
+{
+    __atomic_sub_fetch(&target->liveBytes, bytes, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&target->frees, 1, __ATOMIC_RELAXED);
+}
+
+void InitArenasMemory(void)
+{
+    assert(!dataset && !scratch);
+    dataset = CreateArena(DATASET_ARENA_CHUNK);
+    scratch = CreateArena(SCRATCH_ARENA_CHUNK);
+}
+
+static Arena *ArenaOf(int tag)
+{
+    if (tag == MEMORY_SNAPSHOT)
+        return NULL;
+
+    return tag == MEMORY_SCRATCH ? scratch : dataset;
+}
+
+static void DischargeAll(int tag)
+{
+    long live = __atomic_exchange_n(&stats[tag].liveBytes, 0, __ATOMIC_RELAXED);
+    __atomic_sub_fetch(&stats[MEMORY_TAG_COUNT].liveBytes, live, __ATOMIC_RELAXED);
+}
+
+void ResetScratchMemory(void)
+{
+    if (!scratch)
+        return;
+
+    ResetArena(scratch);
+    DischargeAll(MEMORY_SCRATCH);
+}
+
+void FreeArenasMemory(void)
+{
+    if (!dataset)
+        return;
+
+    FreeArena(dataset);
+    FreeArena(scratch);
+    dataset = scratch = NULL;
+
+    // As cópias de snapshot não estão nas arenas: são liberadas uma a uma.
+    for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+    {
+        if (i != MEMORY_SNAPSHOT)
+            DischargeAll(i);
+    }
+}
+
+void *AllocMemory(int tag, size_t size)
+{
+    assert(tag >= 0 && tag < MEMORY_TAG_COUNT);
+    Arena *arena = ArenaOf(tag);
+    void *ptr = arena ? AllocArena(arena, size) : malloc(size);
+    assert(ptr);
+    Charge(&stats[tag], (long)size);
+    Charge(&stats[MEMORY_TAG_COUNT], (long)size);
+
+    return ptr;
+}
+
+void *CallocMemory(int tag, size_t count, size_t size)
+{
+    assert(tag >= 0 && tag < MEMORY_TAG_COUNT);
+    Arena *arena = ArenaOf(tag);
+    void *ptr = arena ? memset(AllocArena(arena, count * size), 0, count * size) : calloc(count, size);
+    assert(ptr);
+    Charge(&stats[tag], (long)(count * size));
+    Charge(&stats[MEMORY_TAG_COUNT], (long)(count * size));
+
+    return ptr;
+}
+
+void *ReallocMemory(int tag, void *ptr, size_t oldSize, size_t newSize)
+{
+    assert(tag >= 0 && tag < MEMORY_TAG_COUNT);
+    Arena *arena = ArenaOf(tag);
+    void *resized = NULL;
+
+    if (arena)
+    {
+        // A área antiga fica na arena até o fim; crescer dobrando limita o desperdício.
+        resized = AllocArena(arena, newSize);
+
+        if (ptr)
+            memcpy(resized, ptr, oldSize < newSize ? oldSize : newSize);
+    }
+    else
+    {
+        resized = realloc(ptr, newSize);
+    }
+
+    assert(resized);
+
+    if (ptr)
+    {
+        Discharge(&stats[tag], (long)oldSize);
+        Discharge(&stats[MEMORY_TAG_COUNT], (long)oldSize);
+    }
+
+    Charge(&stats[tag], (long)newSize);
+    Charge(&stats[MEMORY_TAG_COUNT], (long)newSize);
+
+    return resized;
+}
+
+void FreeMemory(int tag, void *ptr, size_t size)
+{
+    assert(tag >= 0 && tag < MEMORY_TAG_COUNT);
+
+    if (!ptr)
+        return;
+
+    if (!ArenaOf(tag))
+        free(ptr);
+
+    Discharge(&stats[tag], (long)size);
+    Discharge(&stats[MEMORY_TAG_COUNT], (long)size);
+}
+
+void GetStatsMemory(int tag, MemoryStats *target)
+{
+    assert(tag >= 0 && tag <= MEMORY_TAG_COUNT);
+    assert(target);
+    target->liveBytes = __atomic_load_n(&stats[tag].liveBytes, __ATOMIC_RELAXED);
+    target->peakBytes = __atomic_load_n(&stats[tag].peakBytes, __ATOMIC_RELAXED);
+    target->allocations = __atomic_load_n(&stats[tag].allocations, __ATOMIC_RELAXED);
+    target->frees = __atomic_load_n(&stats[tag].frees, __ATOMIC_RELAXED);
+}
+
+void WriteReportMemory(FILE *out)
+{
+    assert(out);
+
+    for (int i = 0; i <= MEMORY_TAG_COUNT; i++)
+    {
+        MemoryStats current;
+        GetStatsMemory(i, &current);
+        fprintf(out, "memory %s live_bytes %ld peak_bytes %ld allocations %ld frees %ld\n",
+                i < MEMORY_TAG_COUNT ? tagNames[i] : "total",
+                current.liveBytes, current.peakBytes, current.allocations, current.frees);
+    }
+}
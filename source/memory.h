@@ -0,0 +1,147 @@
+/**
+ * @file memory.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the allocation layer that accounts memory per subsystem.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+
+/**
+ * @brief Subsistemas contabilizados, na ordem do relatório.
+ */
+#define MEMORY_CELL 0           // células de listas de livros e de leitores
+#define MEMORY_LIST 1           // cabeçalhos de listas
+#define MEMORY_BOOK 2           // colunas e heap de strings do catálogo de livros
+#define MEMORY_USER 3           // structs de leitores, nomes e preferências
+#define MEMORY_RECOMMENDATION 4 // blocos do pool de recomendações e índices das caixas
+#define MEMORY_AFFINITY 5       // células das listas de afinidades
+#define MEMORY_SCRATCH 6        // listas temporárias de um único comando
+#define MEMORY_INDEX 7          // índices derivados e acumuladores de consultas
+#define MEMORY_SNAPSHOT 8       // snapshots e as cópias de leitores que eles preservam
+#define MEMORY_TAG_COUNT 9
+
+/**
+ * @brief Tamanho dos blocos mapeados pela arena do conjunto de dados.
+ */
+#define DATASET_ARENA_CHUNK (4 << 20)
+
+/**
+ * @brief Tamanho dos blocos mapeados pela arena de rascunho.
+ */
+#define SCRATCH_ARENA_CHUNK (256 << 10)
+
+/**
+ * @brief Contadores de um subsistema.
+ */
+typedef struct
+{
+    long liveBytes;
+    long peakBytes;
+    long allocations;
+    long frees;
+} MemoryStats;
+
+/**
+ * @brief Passa a servir as reservas a partir de duas arenas (ver arena.h).
+ *
+ * Depois desta chamada, tudo o que pertence ao conjunto de dados (todas as
+ * etiquetas exceto MEMORY_SCRATCH e MEMORY_SNAPSHOT) sai da arena do
+ * conjunto de dados, e MEMORY_SCRATCH sai da arena de rascunho.
+ * MEMORY_SNAPSHOT continua no malloc: as cópias de um snapshot voltam ao
+ * sistema quando ele é liberado, e não só no fim. FreeMemory nas arenas só
+ * atualiza a contabilidade: a memória volta em FreeArenasMemory (ou em
+ * ResetScratchMemory, para o rascunho). Quem libera e reserva objetos
+ * do mesmo tamanho com frequência deve reciclá-los por um Pool.
+ *
+ * Deve ser chamada antes de qualquer reserva.
+ */
+void InitArenasMemory(void);
+
+/**
+ * @brief Rebobina a arena de rascunho; chamada ao fim de cada comando.
+ */
+void ResetScratchMemory(void);
+
+/**
+ * @brief Devolve as duas arenas ao sistema, com um munmap por bloco.
+ *
+ * Tudo o que foi reservado nelas deixa de valer de uma vez, sem percorrer
+ * os objetos; as reservas seguintes voltam a usar malloc.
+ */
+void FreeArenasMemory(void);
+
+/**
+ * @brief Reserva @p size bytes contabilizados em @p tag.
+ *
+ * Aborta (assert) se faltar memória.
+ *
+ * @param tag  Uma das constantes MEMORY_*.
+ * @param size Quantidade de bytes.
+ * @return Ponteiro para a área reservada.
+ */
+void *AllocMemory(int tag, size_t size);
+
+/**
+ * @brief Reserva @p count * @p size bytes zerados contabilizados em @p tag.
+ *
+ * @param tag   Uma das constantes MEMORY_*.
+ * @param count Quantidade de elementos.
+ * @param size  Tamanho de cada elemento.
+ * @return Ponteiro para a área reservada.
+ */
+void *CallocMemory(int tag, size_t count, size_t size);
+
+/**
+ * @brief Redimensiona uma área reservada, contabilizando em @p tag.
+ *
+ * Conta como uma liberação do tamanho antigo (se @p ptr não for NULL)
+ * e uma reserva do novo.
+ *
+ * @param tag     Uma das constantes MEMORY_*.
+ * @param ptr     Área atual, ou NULL.
+ * @param oldSize Tamanho atual (0 se @p ptr for NULL).
+ * @param newSize Novo tamanho.
+ * @return Ponteiro para a área redimensionada.
+ */
+void *ReallocMemory(int tag, void *ptr, size_t oldSize, size_t newSize);
+
+/**
+ * @brief Libera uma área reservada por AllocMemory ou CallocMemory.
+ *
+ * O tamanho é informado por quem libera, para que a contabilidade não
+ * precise de cabeçalho extra em cada bloco.
+ *
+ * @param tag  Mesmo subsistema usado na reserva.
+ * @param ptr  Área a ser liberada (NULL é ignorado).
+ * @param size Mesmo tamanho usado na reserva.
+ */
+void FreeMemory(int tag, void *ptr, size_t size);
+
+/**
+ * @brief Lê os contadores de um subsistema.
+ *
+ * @param tag   Uma das constantes MEMORY_*, ou MEMORY_TAG_COUNT para o total.
+ * @param stats Destino da leitura.
+ */
+void GetStatsMemory(int tag, MemoryStats *stats);
+
+/**
+ * @brief Escreve uma linha por subsistema e uma de total.
+ *
+ * Formato:
+ * @verbatim
+ * memory cell live_bytes 0 peak_bytes 480 allocations 30 frees 30
+ * memory total live_bytes 0 peak_bytes 2048 allocations 120 frees 120
+ * @endverbatim
+ *
+ * @param out Arquivo de saída.
+ */
+void WriteReportMemory(FILE *out);
@@ -0,0 +1,256 @@
+/**
+ * @file metrics.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for load-phase timers, per-opcode counters and latency histograms.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <signal.h>
+#include "metrics.h"
+#include "memory.h"
+#include "pager.h"
+
+#define SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_BUCKETS (64 * SUB_BUCKETS)
+
+typedef struct
+{
+    long calls;
+    long errors;
+    long totalNs;
+    long maxNs;
+    long *histogram; // alocado na primeira chamada da operação
+} OpMetrics;
+
+static const char *phaseNames[PHASE_COUNT] = {
+    "load_books",
+    "build_search",
+    "load_users",
+    "build_graph",
+    "replay_journal",
+    "commands",
+};
+
+static const double percentiles[] = {0.5, 0.9, 0.99, 0.999};
+
+static int enabled = 0;
+static int probing = 0; // métricas ou perfil ligados
+static char *destination = NULL;
+static long phaseNs[PHASE_COUNT];
+static long nestedNs = 0; // tempo coberto por fases, para descontar as que ocorrem dentro de um comando
+static OpMetrics ops[METRICS_MAX_OP + 1];
+static long unknownOps = 0;
+static volatile sig_atomic_t reportRequested = 0;
+static char opNames[METRICS_MAX_OP + 1][8]; // nomes dos eventos de trace por operação
+
+static void RequestReport(int signal)
+{
+    (void)signal;
+    reportRequested = 1;
+}
+
+void InitMetrics(void)
+{
+    destination = getenv(METRICS_ENV);
+    enabled = destination && *destination;
+    InitPerf();
+    InitTrace();
+    probing = enabled || IsEnabledPerf() || IsEnabledTrace();
+
+    for (int i = 0; i <= METRICS_MAX_OP; i++)
+        snprintf(opNames[i], sizeof(opNames[i]), "op %d", i);
+
+    if (!enabled)
+        return;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = RequestReport;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &action, NULL);
+}
+
+Probe StartProbeMetrics(void)
+{
+    Probe probe = {0};
+
+    if (!probing)
+        return probe;
+
+    ReadPerf(&probe.counters);
+    probe.ns = NowTrace();
+    probe.nestedNs = nestedNs;
+
+    return probe;
+}
+
+void RecordPhaseMetrics(int phase, Probe *start)
+{
+    if (!probing)
+        return;
+
+    assert(phase >= 0 && phase < PHASE_COUNT);
+
+    long elapsed = NowTrace() - start->ns;
+    nestedNs = start->nestedNs + elapsed; // fases internas já estão dentro de elapsed
+
+    if (enabled)
+        phaseNs[phase] += elapsed;
+
+    RecordPhasePerf(phaseNames[phase], phase, &start->counters);
+    RecordPhaseTrace(phaseNames[phase], start->ns, phase);
+}
+
+/**
+ * @brief Balde de um valor: exato abaixo de SUB_BUCKETS, log-linear acima.
+ */
+static int BucketOf(long value)
+{
+    if (value < SUB_BUCKETS)
+        return value < 0 ? 0 : (int)value;
+
+    int msb = 63 - __builtin_clzl((unsigned long)value);
+    int shift = msb - HISTOGRAM_SUB_BITS;
+
+    return ((shift + 1) << HISTOGRAM_SUB_BITS) | (int)((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+/**
+ * @brief Maior valor que cai no balde @p bucket.
+ */
+static long UpperBoundOf(int bucket)
+{
+    int magnitude = bucket >> HISTOGRAM_SUB_BITS;
+    long sub = bucket & (SUB_BUCKETS - 1);
+
+    if (!magnitude)
+        return sub;
+
+    return ((SUB_BUCKETS + sub + 1) << (magnitude - 1)) - 1;
+}
+
+static long PercentileOf(OpMetrics *op, double percentile)
+{
+    long rank = (long)(percentile * op->calls + 0.5);
+    long seen = 0;
+
+    if (rank < 1)
+        rank = 1;
+
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+    {
+        if ((seen += op->histogram[bucket]) >= rank)
+            return UpperBoundOf(bucket) < op->maxNs ? UpperBoundOf(bucket) : op->maxNs;
+    }
+
+    return op->maxNs;
+}
+
+static void WriteReport(void)
+{
+    FILE *out = strcmp(destination, "stderr") == 0 ? stderr : fopen(destination, "w");
+
+    if (!out)
+        return;
+
+    for (int i = 0; i < PHASE_COUNT; i++)
+        fprintf(out, "phase %s seconds %.6f\n", phaseNames[i], phaseNs[i] / 1e9);
+
+    for (int i = 0; i <= METRICS_MAX_OP; i++)
+    {
+        OpMetrics *op = &ops[i];
+
+        if (!op->calls)
+            continue;
+
+        double seconds = op->totalNs / 1e9;
+        fprintf(out, "op %d calls %ld seconds %.6f ops_per_second %.1f errors %ld mean_ns %ld",
+                i, op->calls, seconds, seconds > 0 ? op->calls / seconds : 0.0,
+                op->errors, op->totalNs / op->calls);
+
+        for (int p = 0; p < (int)(sizeof(percentiles) / sizeof(percentiles[0])); p++)
+            fprintf(out, " p%g_ns %ld", percentiles[p] * 100, PercentileOf(op, percentiles[p]));
+
+        fprintf(out, " max_ns %ld\n", op->maxNs);
+    }
+
+    if (unknownOps)
+        fprintf(out, "unknown_ops %ld\n", unknownOps);
+
+    WriteReportMemory(out);
+    WriteReportPager(out);
+
+    if (out == stderr)
+        fflush(out);
+    else
+        fclose(out);
+}
+
+void RecordCommandMetrics(int op, int failed, Probe *start)
+{
+    if (!probing || op < 0 || op > METRICS_MAX_OP)
+        return;
+
+    long elapsed = NowTrace() - start->ns - (nestedNs - start->nestedNs);
+    RecordCommandPerf(op, &start->counters);
+
+    if (SampleCommandTrace())
+        RecordTrace(opNames[op], "command", start->ns, op);
+
+    if (!enabled)
+        return;
+
+    OpMetrics *metrics = &ops[op];
+
+    if (!metrics->histogram)
+    {
+        metrics->histogram = calloc(HISTOGRAM_BUCKETS, sizeof(long));
+        assert(metrics->histogram);
+    }
+
+    metrics->calls++;
+    metrics->errors += failed != 0;
+    metrics->totalNs += elapsed;
+    metrics->histogram[BucketOf(elapsed)]++;
+
+    if (elapsed > metrics->maxNs)
+        metrics->maxNs = elapsed;
+
+    if (reportRequested)
+    {
+        reportRequested = 0;
+        WriteReport();
+    }
+}
+
+void RecordUnknownCommandMetrics(void)
+{
+    if (enabled)
+        unknownOps++;
+}
+
+void ReportMetrics(void)
+{
+    ReportPerf();
+    WriteTrace();
+    probing = 0;
+
+    if (!enabled)
+        return;
+
+    WriteReport();
+
+    for (int i = 0; i <= METRICS_MAX_OP; i++)
+        free(ops[i].histogram);
+
+    enabled = 0;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file metrics.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for load-phase timers, per-opcode counters and latency histograms.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "perf.h"
+#include "trace.h"
+
+/**
+ * @def METRICS_ENV
+ * @brief Variável de ambiente que liga as métricas.
+ *
+ * "stderr" escreve o relatório na saída de erro; qualquer outro valor é
+ * tratado como caminho de arquivo. Sem a variável, as métricas ficam
+ * desligadas e não custam nada além de um teste por comando.
+ *
+ * O relatório é escrito no fim da execução e também sempre que o processo
+ * recebe SIGUSR1 (o arquivo é reescrito com os números até aquele momento).
+ * Além de fases e operações, traz a memória viva/pico por subsistema
+ * (linhas "memory", ver memory.h).
+ */
+#define METRICS_ENV "BOOKED_METRICS"
+
+/**
+ * @brief Maior código de operação contabilizado.
+ */
+#define METRICS_MAX_OP 63
+
+/**
+ * @brief Bits de sub-balde por potência de 2 nos histogramas de latência.
+ *
+ * Com 4 bits cada potência de 2 é dividida em 16 faixas, o que dá erro
+ * relativo de no máximo 1/16 (~6%) em qualquer percentil, como num HDR
+ * histogram, com tamanho fixo e registro em O(1).
+ */
+#define HISTOGRAM_SUB_BITS 4
+
+/**
+ * @brief Fases de carregamento e execução medidas em main.c.
+ *
+ * PHASE_BUILD_GRAPH é medida em command.c, quando o grafo é de fato
+ * construído (dentro do primeiro comando que o usa). Esse tempo é
+ * descontado da latência daquele comando, para não inflar a cauda do
+ * histograma da operação, mas continua contado em PHASE_COMMANDS, que é
+ * o tempo de parede do laço de comandos. PHASE_BUILD_SEARCH
+ * só acontece na carga completa do catálogo (ver LoadIndexSearch).
+ */
+#define PHASE_LOAD_BOOKS 0
+#define PHASE_BUILD_SEARCH 1
+#define PHASE_LOAD_USERS 2
+#define PHASE_BUILD_GRAPH 3
+#define PHASE_REPLAY_JOURNAL 4
+#define PHASE_COMMANDS 5
+#define PHASE_COUNT 6
+
+/**
+ * @brief Instante de início de uma fase ou comando.
+ *
+ * Guarda o relógio e, se o perfil de hardware estiver ligado (PERF_ENV),
+ * a leitura dos contadores, para que fases e comandos sejam atribuídos
+ * às métricas e ao perfil por um único ponto de instrumentação.
+ */
+typedef struct
+{
+    long ns;
+    long nestedNs; // tempo coberto por fases até aqui, para descontar as aninhadas
+    PerfSample counters;
+} Probe;
+
+/**
+ * @brief Liga as métricas se METRICS_ENV estiver definida, o perfil
+ *        de hardware se PERF_ENV estiver definida e o trace se TRACE_ENV
+ *        estiver definida.
+ */
+void InitMetrics(void);
+
+/**
+ * @brief Marca o início de uma fase ou comando.
+ *
+ * @return Probe com o relógio monotônico (ns) e os contadores de hardware;
+ *         zerado se nada estiver ligado.
+ */
+Probe StartProbeMetrics(void);
+
+/**
+ * @brief Contabiliza uma fase que começou em @p start.
+ *
+ * @param phase Uma das constantes PHASE_*.
+ * @param start Probe obtido por StartProbeMetrics no início da fase.
+ */
+void RecordPhaseMetrics(int phase, Probe *start);
+
+/**
+ * @brief Contabiliza um comando que começou em @p start.
+ *
+ * Soma a chamada, o tempo e a latência no histograma da operação e,
+ * se @p failed, conta um erro (ID de leitor/livro inexistente, etc.).
+ * Fases contabilizadas durante o comando (a construção preguiçosa do
+ * grafo) são descontadas do tempo e da latência.
+ * Também atende pedidos de relatório feitos por SIGUSR1.
+ *
+ * @param op     Código da operação.
+ * @param failed !=0 se o comando retornou COMMAND_FAILED.
+ * @param start  Probe obtido por StartProbeMetrics antes do comando.
+ */
+void RecordCommandMetrics(int op, int failed, Probe *start);
+
+/**
+ * @brief Contabiliza um código de operação não reconhecido.
+ */
+void RecordUnknownCommandMetrics(void);
+
+/**
+ * @brief Escreve os relatórios finais (métricas, perfil e trace) e desliga todos.
+ */
+void ReportMetrics(void);
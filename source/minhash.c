@@ -0,0 +1,243 @@
+/**
+ * @file minhash.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for MinHash signatures of finished books and their LSH index.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include "minhash.h"
+#include "memory.h"
+
+#define EMPTY_SLOT UINT_MAX
+
+typedef struct
+{
+    int prev; // -1 no início do balde
+    int next; // -1 no fim do balde
+    unsigned key;
+} Entry;
+
+typedef struct
+{
+    int capacity;    // posições reservadas
+    int bucketCount; // potência de 2, ao menos 2 * capacity
+    int *heads[MINHASH_BANDS];
+    Entry *entries[MINHASH_BANDS];
+    char *indexed;
+    unsigned *stamp; // evita repetir um candidato presente em várias faixas
+    unsigned generation;
+} LshIndex;
+
+static LshIndex lsh = {0};
+
+static unsigned Mix(unsigned hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+void InitSignatureMinHash(unsigned *signature)
+{
+    assert(signature);
+
+    for (int i = 0; i < MINHASH_SIZE; i++)
+        signature[i] = EMPTY_SLOT;
+}
+
+int AddSignatureMinHash(unsigned *signature, int idBook)
+{
+    assert(signature);
+    int changed = 0;
+
+    for (int i = 0; i < MINHASH_SIZE; i++)
+    {
+        // Uma função de hash por posição: o ID misturado com uma semente distinta.
+        unsigned hash = Mix((unsigned)idBook ^ Mix(0x9E3779B9u * (unsigned)(i + 1)));
+
+        if (hash >= EMPTY_SLOT)
+            hash = EMPTY_SLOT - 1;
+
+        if (hash < signature[i])
+        {
+            signature[i] = hash;
+            changed = 1;
+        }
+    }
+
+    return changed;
+}
+
+int IsEmptySignatureMinHash(unsigned *signature)
+{
+    assert(signature);
+    return signature[0] == EMPTY_SLOT;
+}
+
+int CompareSignatureMinHash(unsigned *signature1, unsigned *signature2)
+{
+    assert(signature1);
+    assert(signature2);
+    int equal = 0;
+
+    for (int i = 0; i < MINHASH_SIZE; i++)
+        equal += signature1[i] == signature2[i];
+
+    return equal;
+}
+
+static unsigned BandKey(unsigned *signature, int band)
+{
+    unsigned key = Mix((unsigned)band + 1);
+
+    for (int row = 0; row < MINHASH_ROWS; row++)
+        key = Mix(key ^ signature[band * MINHASH_ROWS + row]);
+
+    return key;
+}
+
+static void Link(int band, int position)
+{
+    Entry *entry = &lsh.entries[band][position];
+    int *head = &lsh.heads[band][entry->key & (lsh.bucketCount - 1)];
+    entry->prev = -1;
+    entry->next = *head;
+
+    if (*head >= 0)
+        lsh.entries[band][*head].prev = position;
+
+    *head = position;
+}
+
+static void Unlink(int band, int position)
+{
+    Entry *entry = &lsh.entries[band][position];
+
+    if (entry->prev >= 0)
+        lsh.entries[band][entry->prev].next = entry->next;
+    else
+        lsh.heads[band][entry->key & (lsh.bucketCount - 1)] = entry->next;
+
+    if (entry->next >= 0)
+        lsh.entries[band][entry->next].prev = entry->prev;
+}
+
+static void Grow(int position)
+{
+    int capacity = lsh.capacity ? lsh.capacity : 64;
+
+    while (capacity <= position)
+        capacity *= 2;
+
+    int bucketCount = 2 * capacity;
+
+    for (int band = 0; band < MINHASH_BANDS; band++)
+    {
+        lsh.entries[band] = ReallocMemory(MEMORY_INDEX, lsh.entries[band],
+                                          lsh.capacity * sizeof(Entry), capacity * sizeof(Entry));
+        FreeMemory(MEMORY_INDEX, lsh.heads[band], lsh.bucketCount * sizeof(int));
+        lsh.heads[band] = AllocMemory(MEMORY_INDEX, bucketCount * sizeof(int));
+        memset(lsh.heads[band], -1, bucketCount * sizeof(int));
+    }
+
+    lsh.indexed = ReallocMemory(MEMORY_INDEX, lsh.indexed, lsh.capacity, capacity);
+    memset(lsh.indexed + lsh.capacity, 0, capacity - lsh.capacity);
+    lsh.stamp = ReallocMemory(MEMORY_INDEX, lsh.stamp, lsh.capacity * sizeof(unsigned), capacity * sizeof(unsigned));
+    memset(lsh.stamp + lsh.capacity, 0, (capacity - lsh.capacity) * sizeof(unsigned));
+
+    int oldCapacity = lsh.capacity;
+    lsh.capacity = capacity;
+    lsh.bucketCount = bucketCount;
+
+    // As chaves continuam nas entradas: só os baldes são refeitos.
+    for (int i = 0; i < oldCapacity; i++)
+    {
+        if (!lsh.indexed[i])
+            continue;
+
+        for (int band = 0; band < MINHASH_BANDS; band++)
+            Link(band, i);
+    }
+}
+
+void IndexMinHash(int position, unsigned *signature)
+{
+    assert(position >= 0);
+    assert(signature && !IsEmptySignatureMinHash(signature));
+
+    if (position >= lsh.capacity)
+        Grow(position);
+
+    for (int band = 0; band < MINHASH_BANDS; band++)
+    {
+        unsigned key = BandKey(signature, band);
+        Entry *entry = &lsh.entries[band][position];
+
+        if (lsh.indexed[position])
+        {
+            if (entry->key == key)
+                continue;
+
+            Unlink(band, position);
+        }
+
+        entry->key = key;
+        Link(band, position);
+    }
+
+    lsh.indexed[position] = 1;
+}
+
+void ForEachCandidateMinHash(int position, unsigned *signature, minhash_fn fn, void *context)
+{
+    assert(signature);
+    assert(fn);
+
+    if (!lsh.capacity || IsEmptySignatureMinHash(signature))
+        return;
+
+    if (!++lsh.generation)
+    {
+        memset(lsh.stamp, 0, lsh.capacity * sizeof(unsigned));
+        lsh.generation = 1;
+    }
+
+    for (int band = 0; band < MINHASH_BANDS; band++)
+    {
+        unsigned key = BandKey(signature, band);
+
+        for (int cur = lsh.heads[band][key & (lsh.bucketCount - 1)]; cur >= 0; cur = lsh.entries[band][cur].next)
+        {
+            // Baldes podem misturar chaves diferentes: só a chave igual divide a faixa.
+            if (cur == position || lsh.entries[band][cur].key != key || lsh.stamp[cur] == lsh.generation)
+                continue;
+
+            lsh.stamp[cur] = lsh.generation;
+            fn(cur, context);
+        }
+    }
+}
+
+void FreeIndexMinHash(void)
+{
+    for (int band = 0; band < MINHASH_BANDS; band++)
+    {
+        FreeMemory(MEMORY_INDEX, lsh.entries[band], lsh.capacity * sizeof(Entry));
+        FreeMemory(MEMORY_INDEX, lsh.heads[band], lsh.bucketCount * sizeof(int));
+    }
+
+    FreeMemory(MEMORY_INDEX, lsh.indexed, lsh.capacity);
+    FreeMemory(MEMORY_INDEX, lsh.stamp, lsh.capacity * sizeof(unsigned));
+    memset(&lsh, 0, sizeof(lsh));
+}
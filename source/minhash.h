@@ -0,0 +1,95 @@
+/**
+ * @file minhash.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for MinHash signatures of finished books and their LSH index.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+/**
+ * @brief Quantidade de funções de hash (e de posições) de cada assinatura.
+ */
+#define MINHASH_SIZE 32
+
+/**
+ * @brief Faixas do índice LSH; cada faixa cobre MINHASH_SIZE / MINHASH_BANDS posições.
+ *
+ * Com 8 faixas de 4 linhas, dois leitores com Jaccard s viram candidatos
+ * com probabilidade 1 - (1 - s^4)^8: ~0,4 para s = 0,5 e ~0,9 para s = 0,7.
+ */
+#define MINHASH_BANDS 8
+#define MINHASH_ROWS (MINHASH_SIZE / MINHASH_BANDS)
+
+/**
+ * @brief Função chamada para cada candidato do índice.
+ */
+typedef void (*minhash_fn)(int position, void *context);
+
+/**
+ * @brief Inicializa a assinatura de um conjunto vazio.
+ *
+ * @param signature Vetor de MINHASH_SIZE posições.
+ */
+void InitSignatureMinHash(unsigned *signature);
+
+/**
+ * @brief Acrescenta um livro à assinatura (mínimo de cada função de hash).
+ *
+ * @param signature Vetor de MINHASH_SIZE posições.
+ * @param idBook    ID do livro.
+ * @return 1 se alguma posição mudou, 0 caso contrário.
+ */
+int AddSignatureMinHash(unsigned *signature, int idBook);
+
+/**
+ * @brief Verifica se a assinatura é de um conjunto vazio.
+ *
+ * @param signature Vetor de MINHASH_SIZE posições.
+ * @return 1 se vazia, 0 caso contrário.
+ */
+int IsEmptySignatureMinHash(unsigned *signature);
+
+/**
+ * @brief Estima a similaridade de Jaccard entre dois conjuntos.
+ *
+ * @param signature1 Assinatura do primeiro conjunto.
+ * @param signature2 Assinatura do segundo conjunto.
+ * @return Quantidade de posições iguais (0 a MINHASH_SIZE); divida por
+ *         MINHASH_SIZE para obter a estimativa.
+ */
+int CompareSignatureMinHash(unsigned *signature1, unsigned *signature2);
+
+/**
+ * @brief Insere ou reposiciona um leitor no índice LSH.
+ *
+ * Deve ser chamada sempre que a assinatura de @p position mudar. Cada
+ * faixa tem uma tabela de hash; o leitor sai do balde da chave antiga e
+ * entra no da nova em O(1) por faixa.
+ *
+ * @param position  Posição do leitor (GetIndexUser, >= 0).
+ * @param signature Assinatura atual do leitor (não vazia).
+ */
+void IndexMinHash(int position, unsigned *signature);
+
+/**
+ * @brief Chama @p fn uma vez para cada leitor que divide ao menos uma faixa com @p signature.
+ *
+ * O próprio @p position (se >= 0) é ignorado. O custo é proporcional ao
+ * tamanho dos baldes visitados, e não à quantidade de leitores.
+ *
+ * @param position  Posição do leitor consultado, ou -1.
+ * @param signature Assinatura consultada.
+ * @param fn        Função chamada para cada candidato.
+ * @param context   Repassado a @p fn.
+ */
+void ForEachCandidateMinHash(int position, unsigned *signature, minhash_fn fn, void *context);
+
+/**
+ * @brief Libera o índice LSH.
+ */
+void FreeIndexMinHash(void);
@@ -0,0 +1,224 @@
+/**
+ * @file pager.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the page file and its buffer pool (CLOCK eviction).
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "pager.h"
+
+typedef struct
+{
+    int page; // -1 se livre
+    int pins;
+    char dirty;
+    char referenced; // segunda chance do CLOCK
+    char *data;
+} Frame;
+
+struct pager
+{
+    int fd;
+    char *path;
+    int pageCount;
+    int frameCount;
+    int hand; // ponteiro do CLOCK
+    Frame *frames;
+    int *frameOf; // quadro de cada página (-1 se só no arquivo)
+    int frameOfCapacity;
+};
+
+static int opened = 0;
+static long hits = 0;
+static long misses = 0;
+static long evictions = 0;
+static long writebacks = 0;
+static long pages = 0;
+
+Pager *OpenPager(char *path, int frameCount)
+{
+    assert(path);
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+
+    if (fd < 0)
+        return NULL;
+
+    Pager *pager = malloc(sizeof(Pager));
+    assert(pager);
+    pager->fd = fd;
+    pager->path = strdup(path);
+    pager->pageCount = 0;
+    pager->frameCount = frameCount < PAGER_MIN_FRAMES ? PAGER_MIN_FRAMES : frameCount;
+    pager->hand = 0;
+    pager->frames = calloc(pager->frameCount, sizeof(Frame));
+    assert(pager->frames);
+    pager->frameOf = NULL;
+    pager->frameOfCapacity = 0;
+
+    for (int i = 0; i < pager->frameCount; i++)
+    {
+        pager->frames[i].page = -1;
+        pager->frames[i].data = malloc(PAGER_PAGE_SIZE);
+        assert(pager->frames[i].data);
+    }
+
+    opened = 1;
+
+    return pager;
+}
+
+int AppendPagePager(Pager *pager)
+{
+    assert(pager);
+
+    if (pager->pageCount == pager->frameOfCapacity)
+    {
+        int capacity = pager->frameOfCapacity ? 2 * pager->frameOfCapacity : 64;
+        pager->frameOf = realloc(pager->frameOf, capacity * sizeof(int));
+        assert(pager->frameOf);
+
+        for (int i = pager->frameOfCapacity; i < capacity; i++)
+            pager->frameOf[i] = -1;
+
+        pager->frameOfCapacity = capacity;
+    }
+
+    pages++;
+
+    return pager->pageCount++;
+}
+
+/**
+ * @brief Grava um quadro alterado no arquivo.
+ *
+ * @return 1 se gravou, 0 se a escrita falhou (o quadro continua alterado).
+ */
+static int WriteBack(Pager *pager, Frame *frame)
+{
+    ssize_t written = pwrite(pager->fd, frame->data, PAGER_PAGE_SIZE, (off_t)frame->page * PAGER_PAGE_SIZE);
+
+    if (written != PAGER_PAGE_SIZE)
+        return 0;
+
+    frame->dirty = 0;
+    writebacks++;
+
+    return 1;
+}
+
+static int Victim(Pager *pager)
+{
+    // Duas voltas bastam: a primeira apaga as segundas chances.
+    for (int step = 0; step < 2 * pager->frameCount; step++)
+    {
+        int index = pager->hand;
+        Frame *frame = &pager->frames[index];
+        pager->hand = (pager->hand + 1) % pager->frameCount;
+
+        if (frame->pins)
+            continue;
+
+        if (frame->page >= 0 && frame->referenced)
+        {
+            frame->referenced = 0;
+            continue;
+        }
+
+        return index;
+    }
+
+    assert(!"todas as páginas do buffer pool estão fixadas");
+    return -1;
+}
+
+void *PinPager(Pager *pager, int page)
+{
+    assert(pager);
+    assert(page >= 0 && page < pager->pageCount);
+    int index = pager->frameOf[page];
+
+    if (index >= 0)
+    {
+        hits++;
+    }
+    else
+    {
+        misses++;
+        index = Victim(pager);
+        Frame *frame = &pager->frames[index];
+
+        if (frame->page >= 0)
+        {
+            // Sem gravar, a vítima fica onde está e nada foi perdido.
+            if (frame->dirty && !WriteBack(pager, frame))
+                return NULL;
+
+            pager->frameOf[frame->page] = -1;
+            frame->page = -1;
+            evictions++;
+        }
+
+        // Páginas que nunca foram gravadas ficam além do fim do arquivo: leem zeros.
+        ssize_t bytes = pread(pager->fd, frame->data, PAGER_PAGE_SIZE, (off_t)page * PAGER_PAGE_SIZE);
+
+        if (bytes < 0)
+            return NULL;
+
+        memset(frame->data + bytes, 0, PAGER_PAGE_SIZE - bytes);
+
+        frame->page = page;
+        frame->dirty = 0;
+        pager->frameOf[page] = index;
+    }
+
+    Frame *frame = &pager->frames[index];
+    frame->pins++;
+    frame->referenced = 1;
+
+    return frame->data;
+}
+
+void UnpinPager(Pager *pager, int page, int dirty)
+{
+    assert(pager);
+    assert(page >= 0 && page < pager->pageCount);
+    int index = pager->frameOf[page];
+    assert(index >= 0 && pager->frames[index].pins > 0);
+    pager->frames[index].pins--;
+    pager->frames[index].dirty |= dirty != 0;
+}
+
+void ClosePager(Pager *pager)
+{
+    assert(pager);
+
+    for (int i = 0; i < pager->frameCount; i++)
+        free(pager->frames[i].data);
+
+    free(pager->frames);
+    free(pager->frameOf);
+    close(pager->fd);
+    unlink(pager->path);
+    free(pager->path);
+    free(pager);
+}
+
+void WriteReportPager(FILE *out)
+{
+    assert(out);
+
+    if (!opened)
+        return;
+
+    fprintf(out, "pager hits %ld misses %ld evictions %ld writebacks %ld pages %ld\n",
+            hits, misses, evictions, writebacks, pages);
+}
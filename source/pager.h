@@ -0,0 +1,96 @@
+/**
+ * @file pager.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the page file and its buffer pool (CLOCK eviction).
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+
+/**
+ * @brief Tamanho de cada página do arquivo, em bytes.
+ */
+#define PAGER_PAGE_SIZE 4096
+
+/**
+ * @brief Quantidade mínima de quadros no buffer pool.
+ */
+#define PAGER_MIN_FRAMES 4
+
+/**
+ * @brief Tipo opaco que representa um arquivo de páginas com buffer pool.
+ *
+ * Só @p frameCount páginas ficam em memória; as demais ficam no arquivo.
+ * Ao precisar de um quadro, o pool escolhe a vítima pelo algoritmo CLOCK
+ * (segunda chance): páginas usadas recentemente sobrevivem a uma volta
+ * do ponteiro, e páginas alteradas são gravadas antes de sair.
+ */
+typedef struct pager Pager;
+
+/**
+ * @brief Cria (ou trunca) o arquivo de páginas.
+ *
+ * O arquivo é só uma área de despejo deste processo: é apagado em ClosePager.
+ *
+ * @param path       Caminho do arquivo.
+ * @param frameCount Quadros do buffer pool (no mínimo PAGER_MIN_FRAMES).
+ * @return Ponteiro para o Pager, ou NULL se o arquivo não puder ser criado.
+ */
+Pager *OpenPager(char *path, int frameCount);
+
+/**
+ * @brief Acrescenta uma página zerada ao fim do arquivo.
+ *
+ * @param pager Ponteiro para o Pager.
+ * @return Número da nova página.
+ */
+int AppendPagePager(Pager *pager);
+
+/**
+ * @brief Traz uma página para o buffer pool e a fixa.
+ *
+ * A página não é despejada enquanto estiver fixada; cada PinPager bem
+ * sucedido deve ter um UnpinPager correspondente. Se a gravação da
+ * vítima ou a leitura da página falhar, nada fica fixado e as páginas
+ * em memória continuam como estavam.
+ *
+ * @param pager Ponteiro para o Pager.
+ * @param page  Número da página.
+ * @return Ponteiro para os PAGER_PAGE_SIZE bytes da página, ou NULL se a
+ *         leitura ou gravação no arquivo falhar.
+ */
+void *PinPager(Pager *pager, int page);
+
+/**
+ * @brief Solta uma página fixada por PinPager.
+ *
+ * @param pager Ponteiro para o Pager.
+ * @param page  Número da página.
+ * @param dirty !=0 se a página foi alterada (será gravada ao ser despejada).
+ */
+void UnpinPager(Pager *pager, int page, int dirty);
+
+/**
+ * @brief Libera o buffer pool, fecha e apaga o arquivo.
+ *
+ * @param pager Ponteiro para o Pager.
+ */
+void ClosePager(Pager *pager);
+
+/**
+ * @brief Escreve os contadores de todos os Pagers já abertos.
+ *
+ * Formato (nada é escrito se nenhum Pager foi aberto):
+ * @verbatim
+ * pager hits 1200 misses 30 evictions 10 writebacks 8 pages 42
+ * @endverbatim
+ *
+ * @param out Arquivo de saída.
+ */
+void WriteReportPager(FILE *out);
@@ -0,0 +1,226 @@
+/**
+ * @file perf.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for hardware performance-counter profiling (perf_event_open).
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include "perf.h"
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+typedef struct
+{
+    const char *name;
+    long calls;
+    unsigned long totals[PERF_EVENT_COUNT];
+} PerfScope;
+
+static const char *eventNames[PERF_EVENT_COUNT] = {
+    "cycles",
+    "instructions",
+    "l1d_read_misses",
+    "llc_misses",
+    "branches",
+    "branch_misses",
+};
+
+static int enabled = 0;
+static char *destination = NULL;
+static int leader = -1;
+static int eventCount = 0;              // eventos que o kernel aceitou
+static int slotOf[PERF_EVENT_COUNT];    // posição de cada evento na leitura do grupo (-1 = indisponível)
+static int fds[PERF_EVENT_COUNT];
+static PerfScope phases[PERF_MAX_SCOPES];
+static PerfScope ops[PERF_MAX_SCOPES];
+
+#ifdef __linux__
+static int OpenEvent(unsigned type, unsigned long config, int group)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+#endif
+
+void InitPerf(void)
+{
+    destination = getenv(PERF_ENV);
+
+    if (!destination || !*destination)
+        return;
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+        slotOf[i] = -1;
+
+#ifdef __linux__
+    const unsigned types[PERF_EVENT_COUNT] = {
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HW_CACHE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+    };
+    const unsigned long configs[PERF_EVENT_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+
+    // Todos os eventos num só grupo: uma única read() devolve todos juntos.
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        int fd = OpenEvent(types[i], configs[i], leader);
+
+        if (fd < 0)
+            continue;
+
+        if (leader == -1)
+            leader = fd;
+
+        fds[eventCount] = fd;
+        slotOf[i] = eventCount++;
+    }
+
+    if (leader == -1)
+    {
+        fprintf(stderr, "[AVISO] - perf_event_open indisponível; relatório de contadores ficará vazio\n");
+    }
+    else
+    {
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+
+    enabled = 1;
+}
+
+int IsEnabledPerf(void)
+{
+    return enabled;
+}
+
+void ReadPerf(PerfSample *sample)
+{
+    assert(sample);
+    memset(sample, 0, sizeof(*sample));
+
+    if (!enabled || leader == -1)
+        return;
+
+    unsigned long buffer[1 + PERF_EVENT_COUNT];
+
+    if (read(leader, buffer, sizeof(buffer)) < (ssize_t)((1 + eventCount) * sizeof(unsigned long)))
+        return;
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        if (slotOf[i] >= 0)
+            sample->values[i] = buffer[1 + slotOf[i]];
+    }
+}
+
+static void Accumulate(PerfScope *scope, PerfSample *start)
+{
+    PerfSample now;
+    ReadPerf(&now);
+    scope->calls++;
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+        scope->totals[i] += now.values[i] - start->values[i];
+}
+
+void RecordPhasePerf(const char *phaseName, int phase, PerfSample *start)
+{
+    if (!enabled || phase < 0 || phase >= PERF_MAX_SCOPES)
+        return;
+
+    phases[phase].name = phaseName;
+    Accumulate(&phases[phase], start);
+}
+
+void RecordCommandPerf(int op, PerfSample *start)
+{
+    if (!enabled || op < 0 || op >= PERF_MAX_SCOPES)
+        return;
+
+    Accumulate(&ops[op], start);
+}
+
+static void WriteScope(FILE *out, const char *scope, const char *name, PerfScope *totals)
+{
+    fprintf(out, "%s,%s,%ld", scope, name, totals->calls);
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        if (slotOf[i] >= 0)
+            fprintf(out, ",%lu", totals->totals[i]);
+        else
+            fprintf(out, ",");
+    }
+
+    fprintf(out, "\n");
+}
+
+void ReportPerf(void)
+{
+    if (!enabled)
+        return;
+
+    FILE *out = fopen(destination, "w");
+    assert(out);
+    fprintf(out, "scope,name,calls");
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+        fprintf(out, ",%s", eventNames[i]);
+
+    fprintf(out, "\n");
+
+    for (int i = 0; i < PERF_MAX_SCOPES; i++)
+    {
+        if (phases[i].calls)
+            WriteScope(out, "phase", phases[i].name, &phases[i]);
+    }
+
+    for (int i = 0; i < PERF_MAX_SCOPES; i++)
+    {
+        char name[16];
+        snprintf(name, sizeof(name), "%d", i);
+
+        if (ops[i].calls)
+            WriteScope(out, "op", name, &ops[i]);
+    }
+
+    fclose(out);
+
+    for (int i = 0; i < eventCount; i++)
+        close(fds[i]);
+
+    enabled = 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file perf.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for hardware performance-counter profiling (perf_event_open).
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+/**
+ * @def PERF_ENV
+ * @brief Variável de ambiente com o caminho do relatório de contadores (CSV).
+ *
+ * Sem a variável, nenhum contador é aberto. Se o kernel recusar algum
+ * evento (perf_event_paranoid, máquina virtual, etc.), a coluna dele
+ * sai vazia no relatório e os demais continuam sendo medidos.
+ */
+#define PERF_ENV "BOOKED_PERF"
+
+/**
+ * @brief Eventos de hardware medidos, na ordem das colunas do relatório.
+ */
+#define PERF_CYCLES 0
+#define PERF_INSTRUCTIONS 1
+#define PERF_L1D_READ_MISSES 2
+#define PERF_LLC_MISSES 3
+#define PERF_BRANCHES 4
+#define PERF_BRANCH_MISSES 5
+#define PERF_EVENT_COUNT 6
+
+/**
+ * @brief Quantidade máxima de fases e de operações contabilizadas.
+ */
+#define PERF_MAX_SCOPES 64
+
+/**
+ * @brief Leitura de todos os contadores num instante.
+ */
+typedef struct
+{
+    unsigned long values[PERF_EVENT_COUNT];
+} PerfSample;
+
+/**
+ * @brief Abre os contadores se PERF_ENV estiver definida.
+ */
+void InitPerf(void);
+
+/**
+ * @brief Verifica se algum contador está aberto.
+ *
+ * @return 1 se ligado, 0 caso contrário.
+ */
+int IsEnabledPerf(void);
+
+/**
+ * @brief Lê todos os contadores de uma vez.
+ *
+ * @param sample Destino da leitura (zerado se desligado).
+ */
+void ReadPerf(PerfSample *sample);
+
+/**
+ * @brief Atribui a uma fase os eventos ocorridos desde @p start.
+ *
+ * @param phaseName Nome da fase no relatório.
+ * @param phase     Índice da fase (0 a PERF_MAX_SCOPES - 1).
+ * @param start     Leitura feita no início da fase.
+ */
+void RecordPhasePerf(const char *phaseName, int phase, PerfSample *start);
+
+/**
+ * @brief Atribui a uma operação os eventos ocorridos desde @p start.
+ *
+ * @param op    Código da operação (0 a PERF_MAX_SCOPES - 1).
+ * @param start Leitura feita antes do comando.
+ */
+void RecordCommandPerf(int op, PerfSample *start);
+
+/**
+ * @brief Escreve o relatório CSV, fecha os contadores e desliga o perfil.
+ *
+ * Formato: uma linha de cabeçalho e uma linha por fase/operação:
+ * @verbatim
+ * scope,name,calls,cycles,instructions,l1d_read_misses,llc_misses,branches,branch_misses
+ * phase,load_books,1,...
+ * op,1,6005,...
+ * @endverbatim
+ */
+void ReportPerf(void);
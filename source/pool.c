@@ -0,0 +1,109 @@
+/**
+ * @file pool.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the fixed-size object pool allocator.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include "pool.h"
+#include "memory.h"
+
+typedef struct block Block;
+
+struct block
+{
+    Block *next;
+};
+
+struct pool
+{
+    int tag;
+    size_t objectSize;
+    int objectsPerBlock;
+    Block *blocks;  // blocos reservados, para liberar no final
+    void *freeList; // objetos livres, encadeados pelo primeiro ponteiro
+};
+
+Pool *CreatePool(int tag, size_t objectSize, int objectsPerBlock)
+{
+    assert(objectsPerBlock > 0);
+    Pool *pool = AllocMemory(tag, sizeof(Pool));
+    pool->tag = tag;
+
+    // Cada objeto livre guarda o ponteiro para o próximo: precisa caber um void* alinhado.
+    size_t align = sizeof(void *);
+    pool->objectSize = objectSize < align ? align : (objectSize + align - 1) / align * align;
+    pool->objectsPerBlock = objectsPerBlock;
+    pool->blocks = NULL;
+    pool->freeList = NULL;
+
+    return pool;
+}
+
+static size_t BlockSize(Pool *pool, size_t *header)
+{
+    *header = (sizeof(Block) + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+
+    return *header + pool->objectSize * pool->objectsPerBlock;
+}
+
+static void GrowPool(Pool *pool)
+{
+    size_t header = 0;
+    Block *block = AllocMemory(pool->tag, BlockSize(pool, &header));
+    block->next = pool->blocks;
+    pool->blocks = block;
+
+    char *objects = (char *)block + header;
+
+    for (int i = pool->objectsPerBlock - 1; i >= 0; i--)
+    {
+        void **object = (void **)(objects + i * pool->objectSize);
+        *object = pool->freeList;
+        pool->freeList = object;
+    }
+}
+
+void *AllocPool(Pool *pool)
+{
+    assert(pool);
+
+    if (!pool->freeList)
+        GrowPool(pool);
+
+    void **object = pool->freeList;
+    pool->freeList = *object;
+
+    return object;
+}
+
+void ReturnPool(Pool *pool, void *ptr)
+{
+    assert(pool);
+    assert(ptr);
+    *(void **)ptr = pool->freeList;
+    pool->freeList = ptr;
+}
+
+void FreePool(Pool *pool)
+{
+    assert(pool);
+    size_t header = 0;
+    size_t blockSize = BlockSize(pool, &header);
+    Block *block = pool->blocks;
+
+    while (block)
+    {
+        Block *next = block->next;
+        FreeMemory(pool->tag, block, blockSize);
+        block = next;
+    }
+
+    FreeMemory(pool->tag, pool, sizeof(Pool));
+}
@@ -0,0 +1,58 @@
+/**
+ * @file pool.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the fixed-size object pool allocator.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * @brief Tipo opaco que representa um pool de objetos de tamanho fixo.
+ *
+ * Os objetos são reservados em blocos de @p objectsPerBlock unidades e
+ * reaproveitados por uma lista livre, trocando um malloc/free por objeto
+ * por um push/pop de ponteiro.
+ */
+typedef struct pool Pool;
+
+/**
+ * @brief Cria um pool vazio.
+ *
+ * @param tag             Subsistema (MEMORY_*) ao qual os blocos são contabilizados.
+ * @param objectSize      Tamanho de cada objeto, em bytes.
+ * @param objectsPerBlock Quantidade de objetos reservados por bloco.
+ * @return Ponteiro para o novo Pool.
+ */
+Pool *CreatePool(int tag, size_t objectSize, int objectsPerBlock);
+
+/**
+ * @brief Obtém um objeto do pool (conteúdo indefinido).
+ *
+ * @param pool Ponteiro para o Pool.
+ * @return Ponteiro para o objeto.
+ */
+void *AllocPool(Pool *pool);
+
+/**
+ * @brief Devolve um objeto ao pool.
+ *
+ * @param pool Ponteiro para o Pool de onde o objeto saiu.
+ * @param ptr  Ponteiro para o objeto.
+ */
+void ReturnPool(Pool *pool, void *ptr);
+
+/**
+ * @brief Libera todos os blocos do pool e o próprio pool.
+ *
+ * Os objetos ainda em uso deixam de ser válidos.
+ *
+ * @param pool Ponteiro para o Pool.
+ */
+void FreePool(Pool *pool);
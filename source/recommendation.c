@@ -1,7 +1,7 @@
 /**
  * @file recommendation.c
  * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
- * @brief Implementation file for functions that manipulate recommendation.
+ * @brief Implementation file for functions that manipulate recommendations and the per-user inbox.
  * @version 0.1
  * @date 2025-06-25
  *
@@ -12,25 +12,67 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
-#include <stdarg.h>
 #include "recommendation.h"
+#include "pool.h"
+#include "memory.h"
+
+/**
+ * @brief Recomendações reservadas de uma vez em cada bloco do pool.
+ */
+#define RECOMMENDATIONS_PER_BLOCK 256
+
+/**
+ * @brief Quantidade de baldes do índice quando a caixa recebe a primeira recomendação.
+ */
+#define INBOX_INITIAL_BUCKETS 4
 
 struct recommendation
 {
     Book *book;
     User *recommendingUser;
+    int idBook;
+    int idUser;
+    Recommendation *prev;  // ordem de chegada na caixa
+    Recommendation *next;  // ordem de chegada na caixa
+    Recommendation *chain; // próxima no mesmo balde do índice
 };
 
-Recommendation *CreateRecommendation(Book *book, User *recommendingUser)
+static Pool *recommendationPool = NULL;
+
+static Recommendation *InitRecommendation(Recommendation *recommendation, Book *book, User *recommendingUser)
 {
-    Recommendation *recommendation = malloc(sizeof(Recommendation));
-    assert(recommendation);
     recommendation->book = book;
     recommendation->recommendingUser = recommendingUser;
+    recommendation->idBook = GetIdBook(book);
+    recommendation->idUser = GetIdUser(recommendingUser);
+    recommendation->prev = recommendation->next = recommendation->chain = NULL;
 
     return recommendation;
 }
 
+Recommendation *CreateRecommendation(Book *book, User *recommendingUser)
+{
+    if (!recommendationPool)
+        recommendationPool = CreatePool(MEMORY_RECOMMENDATION, sizeof(Recommendation), RECOMMENDATIONS_PER_BLOCK);
+
+    return InitRecommendation(AllocPool(recommendationPool), book, recommendingUser);
+}
+
+void FreeRecommendation(Recommendation *recommendation)
+{
+    assert(recommendation);
+    ReturnPool(recommendationPool, recommendation);
+}
+
+void FreeRecommendationPool(void)
+{
+    if (!recommendationPool)
+        return;
+
+    FreePool(recommendationPool);
+    recommendationPool = NULL;
+}
+
 Book *GetBookRecommendation(Recommendation *recommendation)
 {
     assert(recommendation);
@@ -55,12 +97,173 @@ void PrintRecommendation(void *ptr, int isLast)
     }
 }
 
-int CompareIdRecommendation(void *ptr, va_list args)
+static unsigned HashKey(int idBook, int idUser)
 {
-    Recommendation *recommendation = (Recommendation *)ptr;
+    unsigned hash = (unsigned)idBook * 0x9E3779B1u + (unsigned)idUser;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+
+    return hash;
+}
+
+static Recommendation **BucketInbox(Inbox *inbox, int idBook, int idUser)
+{
+    return &inbox->buckets[HashKey(idBook, idUser) & (inbox->bucketCount - 1)];
+}
+
+static void RehashInbox(Inbox *inbox, int bucketCount)
+{
+    FreeMemory(inbox->memoryTag, inbox->buckets, inbox->bucketCount * sizeof(Recommendation *));
+    inbox->buckets = CallocMemory(inbox->memoryTag, bucketCount, sizeof(Recommendation *));
+    inbox->bucketCount = bucketCount;
+
+    // Inserindo de trás para frente no início de cada balde, cada balde
+    // fica em ordem de chegada: a busca sempre encontra a mais antiga.
+    for (Recommendation *cur = inbox->last; cur; cur = cur->prev)
+    {
+        Recommendation **bucket = BucketInbox(inbox, cur->idBook, cur->idUser);
+        cur->chain = *bucket;
+        *bucket = cur;
+    }
+}
+
+void InitInbox(Inbox *inbox)
+{
+    assert(inbox);
+    inbox->first = inbox->last = NULL;
+    inbox->buckets = NULL;
+    inbox->bucketCount = 0;
+    inbox->length = 0;
+    inbox->memoryTag = MEMORY_RECOMMENDATION;
+}
+
+void PushInbox(Inbox *inbox, Recommendation *recommendation)
+{
+    assert(inbox);
     assert(recommendation);
-    int idBook = va_arg(args, int);
-    int idUser = va_arg(args, int);
 
-    return GetIdBook(recommendation->book) == idBook && GetIdUser(recommendation->recommendingUser) == idUser;
+    recommendation->prev = inbox->last;
+    recommendation->next = NULL;
+
+    if (inbox->last)
+        inbox->last->next = recommendation;
+    else
+        inbox->first = recommendation;
+
+    inbox->last = recommendation;
+    inbox->length++;
+
+    if (inbox->length > inbox->bucketCount)
+    {
+        RehashInbox(inbox, inbox->bucketCount ? inbox->bucketCount * 2 : INBOX_INITIAL_BUCKETS);
+        return; // o rehash já indexou a nova recomendação
+    }
+
+    Recommendation **link = BucketInbox(inbox, recommendation->idBook, recommendation->idUser);
+
+    while (*link)
+        link = &(*link)->chain;
+
+    recommendation->chain = NULL;
+    *link = recommendation;
+}
+
+/**
+ * @brief Retorna o endereço do ponteiro que aponta para a recomendação procurada,
+ *        para que ela possa ser desencadeada sem uma segunda busca.
+ */
+static Recommendation **LinkInbox(Inbox *inbox, int idBook, int idUser)
+{
+    if (!inbox->bucketCount)
+        return NULL;
+
+    Recommendation **link = BucketInbox(inbox, idBook, idUser);
+
+    while (*link && ((*link)->idBook != idBook || (*link)->idUser != idUser))
+        link = &(*link)->chain;
+
+    return *link ? link : NULL;
+}
+
+Recommendation *FindInbox(Inbox *inbox, int idBook, int idUser)
+{
+    assert(inbox);
+    Recommendation **link = LinkInbox(inbox, idBook, idUser);
+
+    return link ? *link : NULL;
+}
+
+Recommendation *TakeInbox(Inbox *inbox, int idBook, int idUser)
+{
+    assert(inbox);
+    Recommendation **link = LinkInbox(inbox, idBook, idUser);
+
+    if (!link)
+        return NULL;
+
+    Recommendation *recommendation = *link;
+    *link = recommendation->chain;
+
+    if (recommendation->prev)
+        recommendation->prev->next = recommendation->next;
+    else
+        inbox->first = recommendation->next;
+
+    if (recommendation->next)
+        recommendation->next->prev = recommendation->prev;
+    else
+        inbox->last = recommendation->prev;
+
+    recommendation->prev = recommendation->next = recommendation->chain = NULL;
+    inbox->length--;
+
+    return recommendation;
+}
+
+void PrintInbox(Inbox *inbox)
+{
+    assert(inbox);
+
+    for (Recommendation *cur = inbox->first; cur; cur = cur->next)
+        PrintRecommendation(cur, !cur->next);
+}
+
+void InitCopyInbox(Inbox *copy, Inbox *inbox, int tag)
+{
+    assert(inbox);
+    InitInbox(copy);
+    copy->memoryTag = tag;
+
+    for (Recommendation *cur = inbox->first; cur; cur = cur->next)
+    {
+        Recommendation *recommendation = tag == MEMORY_RECOMMENDATION
+                                             ? CreateRecommendation(cur->book, cur->recommendingUser)
+                                             : InitRecommendation(AllocMemory(tag, sizeof(Recommendation)), cur->book, cur->recommendingUser);
+        PushInbox(copy, recommendation);
+    }
+}
+
+void ReleaseInbox(Inbox *inbox)
+{
+    assert(inbox);
+    Recommendation *cur = inbox->first;
+
+    int tag = inbox->memoryTag;
+
+    while (cur)
+    {
+        Recommendation *next = cur->next;
+
+        if (tag == MEMORY_RECOMMENDATION)
+            FreeRecommendation(cur);
+        else
+            FreeMemory(tag, cur, sizeof(Recommendation));
+
+        cur = next;
+    }
+
+    FreeMemory(tag, inbox->buckets, inbox->bucketCount * sizeof(Recommendation *));
+    InitInbox(inbox);
+    inbox->memoryTag = tag;
 }
@@ -1,7 +1,7 @@
 /**
  * @file recommendation.h
  * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
- * @brief Header file for functions that manipulate recommendation.
+ * @brief Header file for functions that manipulate recommendations and the per-user inbox.
  * @version 0.1
  * @date 2025-06-25
  *
@@ -52,10 +52,105 @@ User *GetRecommendingUserRecommendation(Recommendation *recommendation);
 void PrintRecommendation(void *ptr, int isLast);
 
 /**
- * @brief Compara uma recomendação por ID do livro.
+ * @brief Devolve uma recomendação ao pool de recomendações.
  *
- * @param ptr  Ponteiro para Recommendation.
- * @param args va_list contendo o ID do livro e o ID do usuário a comparar.
- * @return !=0 se o ID coincidir, 0 caso contrário.
+ * @param recommendation Ponteiro para Recommendation (já fora de qualquer Inbox).
  */
-int CompareIdRecommendation(void *ptr, va_list args);
+void FreeRecommendation(Recommendation *recommendation);
+
+/**
+ * @brief Libera o pool de onde saem todas as recomendações.
+ *
+ * Deve ser chamado no final; recomendações ainda em alguma caixa deixam
+ * de valer junto com o pool, sem precisar liberar os usuários antes.
+ */
+void FreeRecommendationPool(void);
+
+/**
+ * @brief Caixa de recomendações recebidas de um usuário.
+ *
+ * Mantém a ordem de chegada (usada na impressão) e um índice hash por
+ * (ID do livro, ID do recomendador), de modo que buscar e retirar uma
+ * recomendação custa O(1) esperado em vez de percorrer a caixa.
+ *
+ * Os campos são expostos só para que a caixa possa ser embutida em
+ * outras structs (ver InitInbox); use sempre as funções abaixo.
+ */
+typedef struct inbox Inbox;
+
+struct inbox
+{
+    Recommendation *first;
+    Recommendation *last;
+    Recommendation **buckets;
+    int bucketCount; // sempre potência de 2 (ou 0 antes da primeira inserção)
+    int length;
+    int memoryTag; // MEMORY_RECOMMENDATION (pool compartilhado) ou a etiqueta de uma cópia
+};
+
+/**
+ * @brief Inicializa uma caixa vazia num espaço já reservado (ex.: embutida em outra struct).
+ *
+ * Uma caixa inicializada assim é desfeita com ReleaseInbox.
+ *
+ * @param inbox Caixa a ser inicializada.
+ */
+void InitInbox(Inbox *inbox);
+
+/**
+ * @brief Inicializa @p copy como cópia de @p inbox, com novas recomendações (mesmos livros e recomendadores).
+ *
+ * Com @p tag diferente de MEMORY_RECOMMENDATION, as recomendações e o
+ * índice da cópia saem dessa etiqueta, fora do pool compartilhado, e
+ * voltam a ela em ReleaseInbox.
+ *
+ * @param copy  Espaço já reservado a ser inicializado.
+ * @param inbox Caixa a ser copiada.
+ * @param tag   Subsistema (MEMORY_*) da cópia.
+ */
+void InitCopyInbox(Inbox *copy, Inbox *inbox, int tag);
+
+/**
+ * @brief Libera as recomendações e o índice de uma caixa criada com InitInbox.
+ *
+ * @param inbox Ponteiro para Inbox.
+ */
+void ReleaseInbox(Inbox *inbox);
+
+/**
+ * @brief Acrescenta uma recomendação ao final da caixa.
+ *
+ * @param inbox          Ponteiro para Inbox.
+ * @param recommendation Ponteiro para Recommendation (passa a pertencer à caixa).
+ */
+void PushInbox(Inbox *inbox, Recommendation *recommendation);
+
+/**
+ * @brief Busca a recomendação mais antiga com a chave dada.
+ *
+ * @param inbox  Ponteiro para Inbox.
+ * @param idBook ID do livro recomendado.
+ * @param idUser ID do usuário que recomendou.
+ * @return Ponteiro para Recommendation, ou NULL se não houver.
+ */
+Recommendation *FindInbox(Inbox *inbox, int idBook, int idUser);
+
+/**
+ * @brief Retira da caixa a recomendação mais antiga com a chave dada.
+ *
+ * Busca e desencadeia numa única passada; a recomendação deixa de
+ * pertencer à caixa e deve ser liberada com FreeRecommendation.
+ *
+ * @param inbox  Ponteiro para Inbox.
+ * @param idBook ID do livro recomendado.
+ * @param idUser ID do usuário que recomendou.
+ * @return Ponteiro para Recommendation retirada, ou NULL se não houver.
+ */
+Recommendation *TakeInbox(Inbox *inbox, int idBook, int idUser);
+
+/**
+ * @brief Imprime as recomendações da caixa na ordem de chegada.
+ *
+ * @param inbox Ponteiro para Inbox.
+ */
+void PrintInbox(Inbox *inbox);
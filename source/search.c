@@ -0,0 +1,562 @@
+/**
+ * @file search.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for text search over the book catalog.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <assert.h>
+#include "search.h"
+#include "book.h"
+#include "utils.h"
+#include "memory.h"
+#include "threadpool.h"
+
+/**
+ * @brief Livros tokenizados por tarefa do pool na construção do índice de termos.
+ */
+#define SEARCH_BOOKS_PER_TASK 256
+
+
+/**
+ * @brief Letra base de cada caractere Latin-1 de U+00C0 a U+00FF ('\0' = copiar).
+ *
+ * Em UTF-8 eles são 0xC3 seguido de 0x80 a 0xBF.
+ */
+static const char latinFold[64] = {
+    'a', 'a', 'a', 'a', 'a', 'a', 'a', 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',  // À a Ï
+    'd', 'n', 'o', 'o', 'o', 'o', 'o', '\0', 'o', 'u', 'u', 'u', 'u', 'y', '\0', 's', // Ð a ß
+    'a', 'a', 'a', 'a', 'a', 'a', 'a', 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',  // à a ï
+    'd', 'n', 'o', 'o', 'o', 'o', 'o', '\0', 'o', 'u', 'u', 'u', 'u', 'y', '\0', 'y', // ð a ÿ
+};
+
+typedef struct
+{
+    int count;      // livros indexados (o catálogo só cresce na carga)
+    int *order;     // posições do catálogo, em ordem de chave
+    unsigned *keys; // deslocamento da chave de cada posição do catálogo em heap
+    char *heap;   // chaves normalizadas, terminadas em '\0'
+    size_t heapLength;
+    size_t heapCapacity;
+} TitleIndex;
+
+static TitleIndex titles = {0};
+
+typedef struct
+{
+    int count;         // livros indexados
+    int termCount;
+    int slotCount;     // potência de 2, pelo menos o dobro de termCount
+    int *slots;        // tabela hash aberta: ID do termo + 1, ou 0 se vazio
+    unsigned *keys;    // deslocamento de cada termo em heap
+    int *first;        // postings do termo t em postings[first[t]..first[t + 1])
+    int *postings;     // posições do catálogo, crescentes em cada termo
+    int postingCount;
+    char *heap;
+    size_t heapLength;
+} TermIndex;
+
+static TermIndex terms = {0};
+
+/**
+ * @brief Textos normalizados e tokens da construção, compartilhados com as tarefas.
+ *
+ * O livro b ocupa text[textStart[b]..textStart[b + 1]) e pode gerar até
+ * tokenStart[b + 1] - tokenStart[b] tokens, gravados a partir de
+ * tokenStart[b]; tokenCount[b] diz quantos gerou de fato.
+ */
+typedef struct
+{
+    int bookCount;
+    char *text;
+    size_t *textStart;
+    int *tokenStart;
+    int *tokenCount;
+    unsigned *tokenOffset; // início do token em text
+    int *tokenLength;
+    unsigned *tokenHash;
+} Tokens;
+
+size_t NormalizeSearch(const char *text, char *out, size_t size)
+{
+    assert(text);
+    assert(out && size > 0);
+    size_t length = 0;
+
+    for (const unsigned char *cur = (const unsigned char *)text; *cur && length + 1 < size; cur++)
+    {
+        if (cur[0] == 0xC3 && cur[1] >= 0x80 && cur[1] <= 0xBF && latinFold[cur[1] - 0x80])
+        {
+            out[length++] = latinFold[cur[1] - 0x80];
+            cur++;
+            continue;
+        }
+
+        out[length++] = (char)tolower(*cur);
+    }
+
+    out[length] = '\0';
+
+    return length;
+}
+
+static int CompareKeys(const void *ptr1, const void *ptr2)
+{
+    int index1 = *(const int *)ptr1;
+    int index2 = *(const int *)ptr2;
+    int cmp = strcmp(titles.heap + titles.keys[index1], titles.heap + titles.keys[index2]);
+
+    return cmp ? cmp : (index1 > index2) - (index1 < index2);
+}
+
+static void FreeTitleIndex(void)
+{
+    if (!titles.order)
+        return;
+
+    FreeMemory(MEMORY_INDEX, titles.order, titles.count * sizeof(int));
+    FreeMemory(MEMORY_INDEX, titles.keys, titles.count * sizeof(unsigned));
+    FreeMemory(MEMORY_INDEX, titles.heap, titles.heapCapacity + 1);
+    memset(&titles, 0, sizeof(titles));
+}
+
+static void BuildTitleIndex(void)
+{
+    FreeTitleIndex();
+    int count = GetCountBooks();
+    size_t capacity = 0;
+
+    for (int i = 0; i < count; i++)
+        capacity += strlen(GetTitleBook(GetByIndexBook(i))) + 1;
+
+    titles.count = count;
+    titles.order = AllocMemory(MEMORY_INDEX, count * sizeof(int));
+    titles.keys = AllocMemory(MEMORY_INDEX, count * sizeof(unsigned));
+    titles.heap = AllocMemory(MEMORY_INDEX, capacity + 1);
+    titles.heapCapacity = capacity;
+
+    // A chave normalizada nunca é mais longa que o título.
+    for (int i = 0; i < count; i++)
+    {
+        char *title = GetTitleBook(GetByIndexBook(i));
+        titles.order[i] = i;
+        titles.keys[i] = (unsigned)titles.heapLength;
+        titles.heapLength += NormalizeSearch(title, titles.heap + titles.heapLength, strlen(title) + 1) + 1;
+    }
+
+    qsort(titles.order, count, sizeof(int), CompareKeys);
+}
+
+static void FreeTermIndex(void);
+
+static int IsWordByte(unsigned char byte)
+{
+    // Bytes >= 0x80 são letras UTF-8 que a normalização não dobrou.
+    return isalnum(byte) || byte >= 0x80;
+}
+
+static unsigned HashTerm(const char *term, int length)
+{
+    unsigned hash = 2166136261u; // FNV-1a
+
+    for (int i = 0; i < length; i++)
+        hash = (hash ^ (unsigned char)term[i]) * 16777619u;
+
+    return hash;
+}
+
+/**
+ * @brief Tokeniza os livros de uma faixa; só escreve nas posições reservadas a eles.
+ */
+static void TokenizeTask(int task, void *context)
+{
+    Tokens *tokens = context;
+    int firstBook = task * SEARCH_BOOKS_PER_TASK;
+    int lastBook = firstBook + SEARCH_BOOKS_PER_TASK < tokens->bookCount ? firstBook + SEARCH_BOOKS_PER_TASK : tokens->bookCount;
+
+    for (int b = firstBook; b < lastBook; b++)
+    {
+        int slot = tokens->tokenStart[b];
+        size_t end = tokens->textStart[b + 1];
+
+        for (size_t i = tokens->textStart[b]; i < end;)
+        {
+            if (!IsWordByte(tokens->text[i]))
+            {
+                i++;
+                continue;
+            }
+
+            size_t start = i;
+
+            while (i < end && IsWordByte(tokens->text[i]))
+                i++;
+
+            tokens->tokenOffset[slot] = (unsigned)start;
+            tokens->tokenLength[slot] = (int)(i - start);
+            tokens->tokenHash[slot] = HashTerm(tokens->text + start, (int)(i - start));
+            slot++;
+        }
+
+        tokens->tokenCount[b] = slot - tokens->tokenStart[b];
+        assert(slot <= tokens->tokenStart[b + 1]);
+    }
+}
+
+/**
+ * @brief Busca um termo na tabela; retorna o endereço da vaga (ocupada por ele ou livre).
+ */
+static int *SlotTerm(int *slots, int slotCount, const char *heap, const unsigned *keys, const char *term, int length, unsigned hash)
+{
+    for (unsigned i = hash & (slotCount - 1);; i = (i + 1) & (slotCount - 1))
+    {
+        int id = slots[i] - 1;
+
+        if (id < 0)
+            return &slots[i];
+
+        const char *key = heap + keys[id];
+
+        if (strncmp(key, term, length) == 0 && key[length] == '\0')
+            return &slots[i];
+    }
+}
+
+static int CapacityFor(int count)
+{
+    int capacity = 16;
+
+    while (capacity < 2 * count)
+        capacity *= 2;
+
+    return capacity;
+}
+
+static void BuildTermIndex(void)
+{
+    FreeTermIndex();
+    Tokens tokens = {0};
+    int n = GetCountBooks();
+    tokens.bookCount = n;
+    tokens.textStart = AllocMemory(MEMORY_SCRATCH, (n + 1) * sizeof(size_t));
+    tokens.tokenStart = AllocMemory(MEMORY_SCRATCH, (n + 1) * sizeof(int));
+    tokens.tokenCount = AllocMemory(MEMORY_SCRATCH, (n > 0 ? n : 1) * sizeof(int));
+
+    // A decodificação preguiçosa e as reservas não são thread-safe: os
+    // textos são normalizados aqui e as tarefas só tokenizam.
+    size_t length = 0;
+
+    for (int b = 0; b < n; b++)
+    {
+        Book *book = GetByIndexBook(b);
+        length += strlen(GetTitleBook(book)) + strlen(GetAuthorBook(book)) + 2;
+    }
+
+    tokens.text = AllocMemory(MEMORY_SCRATCH, length + 1);
+    length = 0;
+    tokens.tokenStart[0] = 0;
+
+    for (int b = 0; b < n; b++)
+    {
+        Book *book = GetByIndexBook(b);
+        char *title = GetTitleBook(book);
+        tokens.textStart[b] = length;
+        length += NormalizeSearch(title, tokens.text + length, strlen(title) + 1);
+        tokens.text[length++] = ' ';
+        char *author = GetAuthorBook(book);
+        length += NormalizeSearch(author, tokens.text + length, strlen(author) + 1);
+        tokens.text[length++] = '\0';
+
+        // Cada token ocupa ao menos um byte mais um separador.
+        tokens.tokenStart[b + 1] = tokens.tokenStart[b] + (int)(length - tokens.textStart[b]) / 2;
+    }
+
+    tokens.textStart[n] = length;
+    int capacity = tokens.tokenStart[n] > 0 ? tokens.tokenStart[n] : 1;
+    tokens.tokenOffset = AllocMemory(MEMORY_SCRATCH, capacity * sizeof(unsigned));
+    tokens.tokenLength = AllocMemory(MEMORY_SCRATCH, capacity * sizeof(int));
+    tokens.tokenHash = AllocMemory(MEMORY_SCRATCH, capacity * sizeof(unsigned));
+
+    if (n)
+        RunThreadPool(GetSharedThreadPool(), TokenizeTask, (n + SEARCH_BOOKS_PER_TASK - 1) / SEARCH_BOOKS_PER_TASK, &tokens);
+
+    // Dicionário: os termos ficam em text (primeira ocorrência) até a cópia final.
+    int slotCount = CapacityFor(capacity);
+    int *slots = AllocMemory(MEMORY_SCRATCH, slotCount * sizeof(int));
+    memset(slots, 0, slotCount * sizeof(int));
+    unsigned *keys = AllocMemory(MEMORY_SCRATCH, capacity * sizeof(unsigned));
+    int *termOf = AllocMemory(MEMORY_SCRATCH, capacity * sizeof(int));
+    int *lastBook = AllocMemory(MEMORY_SCRATCH, capacity * sizeof(int));
+    int *postingCount = AllocMemory(MEMORY_SCRATCH, capacity * sizeof(int));
+    int termCount = 0;
+    size_t heapLength = 0;
+
+    for (int b = 0; b < n; b++)
+    {
+        for (int t = tokens.tokenStart[b]; t < tokens.tokenStart[b] + tokens.tokenCount[b]; t++)
+        {
+            char *term = tokens.text + tokens.tokenOffset[t];
+            int *slot = SlotTerm(slots, slotCount, tokens.text, keys, term, tokens.tokenLength[t], tokens.tokenHash[t]);
+
+            if (!*slot)
+            {
+                term[tokens.tokenLength[t]] = '\0'; // o separador não é mais necessário
+                keys[termCount] = tokens.tokenOffset[t];
+                lastBook[termCount] = -1;
+                postingCount[termCount] = 0;
+                heapLength += tokens.tokenLength[t] + 1;
+                *slot = ++termCount;
+            }
+
+            int id = *slot - 1;
+            termOf[t] = id;
+
+            if (lastBook[id] != b)
+            {
+                lastBook[id] = b;
+                postingCount[id]++;
+            }
+        }
+    }
+
+    // Cópia compacta para a memória do índice.
+    terms.count = n;
+    terms.termCount = termCount;
+    terms.slotCount = CapacityFor(termCount);
+    terms.slots = CallocMemory(MEMORY_INDEX, terms.slotCount, sizeof(int));
+    terms.keys = AllocMemory(MEMORY_INDEX, (termCount > 0 ? termCount : 1) * sizeof(unsigned));
+    terms.first = AllocMemory(MEMORY_INDEX, (termCount + 1) * sizeof(int));
+    terms.heap = AllocMemory(MEMORY_INDEX, heapLength + 1);
+    terms.first[0] = 0;
+
+    for (int id = 0; id < termCount; id++)
+    {
+        char *term = tokens.text + keys[id];
+        int termLength = (int)strlen(term);
+        terms.keys[id] = (unsigned)terms.heapLength;
+        memcpy(terms.heap + terms.heapLength, term, termLength + 1);
+        terms.heapLength += termLength + 1;
+        terms.first[id + 1] = terms.first[id] + postingCount[id];
+        *SlotTerm(terms.slots, terms.slotCount, terms.heap, terms.keys, term, termLength, HashTerm(term, termLength)) = id + 1;
+        lastBook[id] = -1;
+        postingCount[id] = 0;
+    }
+
+    // Os livros são percorridos em ordem: cada lista sai crescente.
+    terms.postingCount = terms.first[termCount];
+    terms.postings = AllocMemory(MEMORY_INDEX, (terms.postingCount > 0 ? terms.postingCount : 1) * sizeof(int));
+
+    for (int b = 0; b < n; b++)
+    {
+        for (int t = tokens.tokenStart[b]; t < tokens.tokenStart[b] + tokens.tokenCount[b]; t++)
+        {
+            int id = termOf[t];
+
+            if (lastBook[id] != b)
+            {
+                lastBook[id] = b;
+                terms.postings[terms.first[id] + postingCount[id]++] = b;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Primeira posição >= @p from de @p list com valor >= @p value (busca galopante).
+ */
+static int Gallop(const int *list, int length, int from, int value)
+{
+    int step = 1;
+    int low = from;
+    int high = from;
+
+    while (high < length && list[high] < value)
+    {
+        low = high + 1;
+        high += step;
+        step *= 2;
+    }
+
+    if (high > length)
+        high = length;
+
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+
+        if (list[middle] < value)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+void PrintTermSearch(char *query, int limit)
+{
+    assert(query);
+    assert(limit > 0);
+
+    if (!terms.first || terms.count != GetCountBooks())
+        BuildTermIndex();
+
+    char key[MAX_LINE_LENGTH];
+    int length = (int)NormalizeSearch(query, key, sizeof(key));
+    // Cada termo ocupa ao menos um byte mais um separador.
+    int *lists = AllocMemory(MEMORY_SCRATCH, (length / 2 + 1) * sizeof(int));
+    int listCount = 0;
+    int missing = 0;
+
+    for (int i = 0; i < length;)
+    {
+        if (!IsWordByte(key[i]))
+        {
+            i++;
+            continue;
+        }
+
+        int start = i;
+
+        while (i < length && IsWordByte(key[i]))
+            i++;
+
+        int id = *SlotTerm(terms.slots, terms.slotCount, terms.heap, terms.keys, key + start, i - start, HashTerm(key + start, i - start)) - 1;
+
+        if (id < 0)
+            missing = 1;
+        else
+            lists[listCount++] = id;
+    }
+
+    // Da lista mais curta para a mais longa: os candidatos só diminuem.
+    for (int i = 1; i < listCount; i++)
+    {
+        int id = lists[i];
+        int j = i;
+
+        for (; j > 0 && terms.first[lists[j - 1] + 1] - terms.first[lists[j - 1]] > terms.first[id + 1] - terms.first[id]; j--)
+            lists[j] = lists[j - 1];
+
+        lists[j] = id;
+    }
+
+    int count = 0;
+    int *candidates = NULL;
+
+    if (listCount && !missing)
+    {
+        count = terms.first[lists[0] + 1] - terms.first[lists[0]];
+        candidates = AllocMemory(MEMORY_SCRATCH, count * sizeof(int));
+        memcpy(candidates, terms.postings + terms.first[lists[0]], count * sizeof(int));
+    }
+
+    for (int l = 1; l < listCount && count; l++)
+    {
+        const int *list = terms.postings + terms.first[lists[l]];
+        int listLength = terms.first[lists[l] + 1] - terms.first[lists[l]];
+        int cursor = 0;
+        int kept = 0;
+
+        for (int c = 0; c < count && cursor < listLength; c++)
+        {
+            cursor = Gallop(list, listLength, cursor, candidates[c]);
+
+            if (cursor < listLength && list[cursor] == candidates[c])
+                candidates[kept++] = candidates[c];
+        }
+
+        count = kept;
+    }
+
+    printf("Livros com \"%s\": ", query);
+
+    for (int i = 0; i < count && i < limit; i++)
+    {
+        Book *book = GetByIndexBook(candidates[i]);
+        printf("%s%s (ID %d)", i ? ", " : "", GetTitleBook(book), GetIdBook(book));
+    }
+
+    if (!count)
+        printf("Nenhum livro");
+
+    printf("\n");
+}
+
+void LoadIndexSearch(void)
+{
+    BuildTitleIndex();
+    BuildTermIndex();
+}
+
+void PrintTitlePrefixSearch(char *prefix, int limit)
+{
+    assert(prefix);
+    assert(limit > 0);
+
+    if (!titles.order || titles.count != GetCountBooks())
+        BuildTitleIndex();
+
+    char key[MAX_LINE_LENGTH];
+    size_t length = NormalizeSearch(prefix, key, sizeof(key));
+
+    // Primeira chave >= prefixo: todas as que começam com ele vêm em seguida.
+    int low = 0;
+    int high = titles.count;
+
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+
+        if (strcmp(titles.heap + titles.keys[titles.order[middle]], key) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    printf("Títulos com \"%s\": ", prefix);
+    int printed = 0;
+
+    for (int i = low; i < titles.count && printed < limit; i++, printed++)
+    {
+        int index = titles.order[i];
+
+        if (strncmp(titles.heap + titles.keys[index], key, length) != 0)
+            break;
+
+        Book *book = GetByIndexBook(index);
+        printf("%s%s (ID %d)", printed ? ", " : "", GetTitleBook(book), GetIdBook(book));
+    }
+
+    if (!printed)
+        printf("Nenhum livro");
+
+    printf("\n");
+}
+
+static void FreeTermIndex(void)
+{
+    if (!terms.first)
+        return;
+
+    FreeMemory(MEMORY_INDEX, terms.slots, terms.slotCount * sizeof(int));
+    FreeMemory(MEMORY_INDEX, terms.keys, (terms.termCount > 0 ? terms.termCount : 1) * sizeof(unsigned));
+    FreeMemory(MEMORY_INDEX, terms.first, (terms.termCount + 1) * sizeof(int));
+    FreeMemory(MEMORY_INDEX, terms.postings, (terms.postingCount > 0 ? terms.postingCount : 1) * sizeof(int));
+    FreeMemory(MEMORY_INDEX, terms.heap, terms.heapLength + 1);
+    memset(&terms, 0, sizeof(terms));
+}
+
+void FreeIndexSearch(void)
+{
+    FreeTitleIndex();
+    FreeTermIndex();
+}
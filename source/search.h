@@ -0,0 +1,94 @@
+/**
+ * @file search.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for text search over the book catalog.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * @brief Normaliza um texto para busca: minúsculas e sem acentos.
+ *
+ * Letras ASCII viram minúsculas e as letras acentuadas do Latin-1 em
+ * UTF-8 (Á, ç, õ, ...) viram a letra base minúscula; os demais bytes
+ * são copiados. O resultado é truncado em @p size - 1 bytes.
+ *
+ * @param text Texto em UTF-8.
+ * @param out  Destino.
+ * @param size Tamanho de @p out.
+ * @return Comprimento do texto normalizado.
+ */
+size_t NormalizeSearch(const char *text, char *out, size_t size);
+
+/**
+ * @brief Constrói os índices de busca do catálogo carregado.
+ *
+ * O índice de títulos guarda as posições do catálogo ordenadas pelo
+ * título normalizado, num único vetor, com as chaves num heap de strings.
+ *
+ * No índice invertido, cada termo (sequência de letras e dígitos do texto
+ * normalizado de título e autor) aponta para a lista crescente das
+ * posições do catálogo que o contêm. Os textos são normalizados na thread
+ * atual e tokenizados em paralelo pelo pool compartilhado; o dicionário e
+ * as listas são montados depois, em ordem.
+ *
+ * Chamada por main.c logo após a carga completa do catálogo; no modo
+ * preguiçoso (BOOKED_LAZY_BOOKS) a construção fica para a primeira
+ * consulta, para que a carga não decodifique todos os títulos. Usa
+ * memória de rascunho: quem chama fora de um comando deve chamar
+ * ResetScratchMemory.
+ */
+void LoadIndexSearch(void);
+
+/**
+ * @brief Imprime até @p limit livros cujo título começa com @p prefix.
+ *
+ * Usa o índice de títulos de LoadIndexSearch, construído aqui mesmo na
+ * primeira consulta se a carga não o construiu (modo preguiçoso). Cada
+ * consulta é uma busca binária pelo primeiro título >= prefixo seguida
+ * de uma varredura dos seguintes: O(log n + limit), sem percorrer o
+ * catálogo.
+ *
+ * Formato (títulos em ordem alfabética normalizada):
+ * @verbatim
+ * Títulos com "<prefixo>": <título> (ID <id>), ...
+ * @endverbatim
+ *
+ * @param prefix Prefixo (comparado já normalizado).
+ * @param limit  Quantidade máxima de livros (> 0).
+ */
+void PrintTitlePrefixSearch(char *prefix, int limit);
+
+/**
+ * @brief Imprime até @p limit livros cujo título ou autor contém todos os termos de @p query.
+ *
+ * Usa o índice invertido de LoadIndexSearch, construído aqui mesmo na
+ * primeira busca se a carga não o construiu (modo preguiçoso) ou se o
+ * catálogo mudou desde então.
+ *
+ * A consulta parte da lista do termo mais raro e a intersecta com as
+ * demais, da mais curta para a mais longa, por busca galopante: o custo
+ * cresce com a lista mais curta, não com o catálogo.
+ *
+ * Formato (ordem do catálogo):
+ * @verbatim
+ * Livros com "<consulta>": <título> (ID <id>), ...
+ * @endverbatim
+ *
+ * @param query Termos separados por espaços ou pontuação (todos obrigatórios,
+ *              sem limite de quantidade).
+ * @param limit Quantidade máxima de livros (> 0).
+ */
+void PrintTermSearch(char *query, int limit);
+
+/**
+ * @brief Libera os índices de busca.
+ */
+void FreeIndexSearch(void);
@@ -0,0 +1,107 @@
+/**
+ * @file snapshot.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for copy-on-write point-in-time views of all users.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include "snapshot.h"
+#include "memory.h"
+
+struct snapshot
+{
+    int length;
+    User **users;       // usuários vivos, na ordem do instante do snapshot
+    unsigned *versions; // versão de cada usuário no instante do snapshot
+    User **frozen;      // cópias feitas por escritores (NULL = estado vivo ainda vale)
+    char *dumped;       // usuários que o dump já imprimiu
+};
+
+static pthread_mutex_t snapshotLock = PTHREAD_MUTEX_INITIALIZER;
+static Snapshot *activeSnapshot = NULL;
+
+Snapshot *TakeSnapshot(List *userList)
+{
+    assert(userList);
+    Snapshot *snapshot = AllocMemory(MEMORY_SNAPSHOT, sizeof(Snapshot));
+    snapshot->length = GetLengthList(userList);
+
+    snapshot->users = AllocMemory(MEMORY_SNAPSHOT, snapshot->length * sizeof(User *));
+    snapshot->versions = AllocMemory(MEMORY_SNAPSHOT, snapshot->length * sizeof(unsigned));
+    snapshot->frozen = CallocMemory(MEMORY_SNAPSHOT, snapshot->length, sizeof(User *));
+    snapshot->dumped = CallocMemory(MEMORY_SNAPSHOT, snapshot->length, sizeof(char));
+
+    int i = 0;
+
+    for (ListCursor cursor = BeginList(userList); !IsEndCursor(&cursor); NextCursor(&cursor), i++)
+    {
+        User *user = GetValueCursor(&cursor);
+        assert(GetIndexUser(user) == i);
+        snapshot->users[i] = user;
+        snapshot->versions[i] = GetVersionUser(user);
+    }
+
+    pthread_mutex_lock(&snapshotLock);
+    assert(!activeSnapshot);
+    activeSnapshot = snapshot;
+    pthread_mutex_unlock(&snapshotLock);
+
+    return snapshot;
+}
+
+void PrintSnapshot(Snapshot *snapshot)
+{
+    assert(snapshot);
+
+    for (int i = 0; i < snapshot->length; i++)
+    {
+        pthread_mutex_lock(&snapshotLock);
+        User *user = snapshot->frozen[i] ? snapshot->frozen[i] : snapshot->users[i];
+        assert(GetVersionUser(user) == snapshot->versions[i]);
+        PrintUser(user, 0);
+        snapshot->dumped[i] = 1;
+        pthread_mutex_unlock(&snapshotLock);
+    }
+}
+
+void ReleaseSnapshot(Snapshot *snapshot)
+{
+    assert(snapshot);
+    pthread_mutex_lock(&snapshotLock);
+
+    if (activeSnapshot == snapshot)
+        activeSnapshot = NULL;
+
+    pthread_mutex_unlock(&snapshotLock);
+
+    for (int i = 0; i < snapshot->length; i++)
+    {
+        if (snapshot->frozen[i])
+            FreeUser(snapshot->frozen[i]);
+    }
+
+    FreeMemory(MEMORY_SNAPSHOT, snapshot->users, snapshot->length * sizeof(User *));
+    FreeMemory(MEMORY_SNAPSHOT, snapshot->versions, snapshot->length * sizeof(unsigned));
+    FreeMemory(MEMORY_SNAPSHOT, snapshot->frozen, snapshot->length * sizeof(User *));
+    FreeMemory(MEMORY_SNAPSHOT, snapshot->dumped, snapshot->length * sizeof(char));
+    FreeMemory(MEMORY_SNAPSHOT, snapshot, sizeof(Snapshot));
+}
+
+void PreserveUserSnapshot(User *user)
+{
+    assert(user);
+    pthread_mutex_lock(&snapshotLock);
+    Snapshot *snapshot = activeSnapshot;
+    int i = GetIndexUser(user);
+
+    if (snapshot && i >= 0 && i < snapshot->length && !snapshot->dumped[i] && !snapshot->frozen[i])
+        snapshot->frozen[i] = CloneUser(user);
+
+    pthread_mutex_unlock(&snapshotLock);
+}
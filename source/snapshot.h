@@ -0,0 +1,63 @@
+/**
+ * @file snapshot.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for copy-on-write point-in-time views of all users.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "list.h"
+#include "user.h"
+
+/**
+ * @brief Tipo opaco que representa uma visão consistente de todos os usuários.
+ *
+ * Tirar um snapshot não copia nada: cada usuário só é copiado se alguém
+ * for alterá-lo antes de o dump chegar nele (copy-on-write por usuário).
+ * Assim o dump lê o estado do instante em que o snapshot foi tirado,
+ * enquanto as mutações seguem sem esperar o dump inteiro.
+ */
+typedef struct snapshot Snapshot;
+
+/**
+ * @brief Tira um snapshot dos usuários e o torna o snapshot ativo.
+ *
+ * Deve ser chamado entre comandos. Só um snapshot pode estar ativo por vez.
+ *
+ * @param userList Lista de usuários (índices densos já atribuídos).
+ * @return Ponteiro para o Snapshot.
+ */
+Snapshot *TakeSnapshot(List *userList);
+
+/**
+ * @brief Imprime todos os usuários como estavam quando o snapshot foi tirado.
+ *
+ * Cada usuário é impresso com o lock do snapshot seguro, de modo que um
+ * escritor concorrente só espera pela impressão daquele usuário.
+ *
+ * @param snapshot Ponteiro para o Snapshot.
+ */
+void PrintSnapshot(Snapshot *snapshot);
+
+/**
+ * @brief Libera o snapshot e as cópias feitas por escritores.
+ *
+ * @param snapshot Ponteiro para o Snapshot.
+ */
+void ReleaseSnapshot(Snapshot *snapshot);
+
+/**
+ * @brief Preserva o estado atual do usuário antes de uma mutação.
+ *
+ * Deve ser chamado por todo escritor imediatamente antes de alterar
+ * lidos, desejados ou recomendações. Se houver snapshot ativo e o dump
+ * ainda não tiver passado pelo usuário, guarda uma cópia dele.
+ *
+ * @param user Ponteiro para User prestes a ser alterado.
+ */
+void PreserveUserSnapshot(User *user);
@@ -0,0 +1,163 @@
+/**
+ * @file threadpool.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the fixed-size worker pool used by batch operations.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "threadpool.h"
+#include "trace.h"
+
+struct threadpool
+{
+    int threadCount;
+    pthread_t *workers; // threadCount - 1: quem chama RunThreadPool também trabalha
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    unsigned batch;  // muda a cada lote: acorda as threads
+    int running;     // threads ainda no lote atual
+    int stop;
+    task_fn fn;
+    void *context;
+    int taskCount;
+    int nextTask;    // contador atômico
+};
+
+static ThreadPool *shared = NULL;
+
+static void Drain(ThreadPool *pool)
+{
+    int task;
+    int tracing = IsEnabledTrace();
+
+    while ((task = __atomic_fetch_add(&pool->nextTask, 1, __ATOMIC_RELAXED)) < pool->taskCount)
+    {
+        long start = tracing ? NowTrace() : 0;
+        pool->fn(task, pool->context);
+
+        if (tracing)
+            RecordTrace("task", "threadpool", start, task);
+    }
+}
+
+static void *Work(void *ptr)
+{
+    ThreadPool *pool = ptr;
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (1)
+    {
+        while (!pool->stop && pool->batch == seen)
+            pthread_cond_wait(&pool->start, &pool->lock);
+
+        if (pool->stop)
+            break;
+
+        seen = pool->batch;
+        pthread_mutex_unlock(&pool->lock);
+
+        Drain(pool);
+
+        pthread_mutex_lock(&pool->lock);
+
+        if (!--pool->running)
+            pthread_cond_signal(&pool->done);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+ThreadPool *CreateThreadPool(int threadCount)
+{
+    assert(threadCount >= 1);
+    ThreadPool *pool = calloc(1, sizeof(ThreadPool));
+    assert(pool);
+    pool->threadCount = threadCount;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->workers = malloc((threadCount - 1) * sizeof(pthread_t) + 1);
+    assert(pool->workers);
+
+    for (int i = 0; i < threadCount - 1; i++)
+        pthread_create(&pool->workers[i], NULL, Work, pool);
+
+    return pool;
+}
+
+ThreadPool *GetSharedThreadPool(void)
+{
+    if (shared)
+        return shared;
+
+    char *threads = getenv(THREADS_ENV);
+    int threadCount = threads && *threads ? atoi(threads) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    shared = CreateThreadPool(threadCount > 0 ? threadCount : 1);
+
+    return shared;
+}
+
+void RunThreadPool(ThreadPool *pool, task_fn fn, int taskCount, void *context)
+{
+    assert(pool);
+    assert(fn);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->context = context;
+    pool->taskCount = taskCount;
+    pool->nextTask = 0;
+    pool->running = pool->threadCount - 1;
+    pool->batch++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    Drain(pool);
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (pool->running)
+        pthread_cond_wait(&pool->done, &pool->lock);
+
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void FreeThreadPool(ThreadPool *pool)
+{
+    assert(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->threadCount - 1; i++)
+        pthread_join(pool->workers[i], NULL);
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    free(pool->workers);
+    free(pool);
+}
+
+void FreeSharedThreadPool(void)
+{
+    if (shared)
+        FreeThreadPool(shared);
+
+    shared = NULL;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file threadpool.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the fixed-size worker pool used by batch operations.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+/**
+ * @def THREADS_ENV
+ * @brief Variável de ambiente com a quantidade de threads do pool compartilhado.
+ *
+ * Sem ela, usa a quantidade de processadores disponíveis.
+ */
+#define THREADS_ENV "BOOKED_THREADS"
+
+/**
+ * @brief Tipo opaco que representa um pool de threads de tamanho fixo.
+ *
+ * As threads são criadas uma vez e dormem entre os lotes. Um lote é uma
+ * quantidade de tarefas numeradas que as threads (e quem chamou) pegam
+ * de um contador atômico até acabarem.
+ *
+ * As tarefas não devem reservar memória por memory.h nem usar o arquivo
+ * de páginas (ver pager.h): arenas, pools e buffer pool não são
+ * thread-safe. Quem chama reserva tudo antes de RunThreadPool.
+ *
+ * Com o trace ligado (ver trace.h), cada tarefa vira um evento "task"
+ * na thread que a executou, com o número da tarefa em args.value.
+ */
+typedef struct threadpool ThreadPool;
+
+/**
+ * @brief Função que executa a tarefa @p task de um lote.
+ */
+typedef void (*task_fn)(int task, void *context);
+
+/**
+ * @brief Cria um pool.
+ *
+ * @param threadCount Quantidade total de threads, contando quem chama
+ *                    RunThreadPool (>= 1; 1 roda tudo na thread atual).
+ * @return Ponteiro para o ThreadPool.
+ */
+ThreadPool *CreateThreadPool(int threadCount);
+
+/**
+ * @brief Obtém o pool compartilhado, criando-o na primeira chamada (ver THREADS_ENV).
+ *
+ * @return Ponteiro para o ThreadPool.
+ */
+ThreadPool *GetSharedThreadPool(void);
+
+/**
+ * @brief Executa as tarefas 0 a @p taskCount - 1 e espera todas terminarem.
+ *
+ * @param pool      Ponteiro para o ThreadPool.
+ * @param fn        Função de cada tarefa.
+ * @param taskCount Quantidade de tarefas.
+ * @param context   Repassado a @p fn.
+ */
+void RunThreadPool(ThreadPool *pool, task_fn fn, int taskCount, void *context);
+
+/**
+ * @brief Encerra as threads e libera o pool.
+ *
+ * @param pool Ponteiro para o ThreadPool.
+ */
+void FreeThreadPool(ThreadPool *pool);
+
+/**
+ * @brief Libera o pool compartilhado, se criado.
+ */
+void FreeSharedThreadPool(void);
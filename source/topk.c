@@ -0,0 +1,143 @@
+/**
+ * @file topk.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the bounded min-heap that keeps the K best-scored items.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <assert.h>
+#include "topk.h"
+#include "memory.h"
+
+typedef struct
+{
+    int item;
+    long score;
+} Entry;
+
+struct topk
+{
+    int capacity;
+    int count;
+    Entry *heap; // heap[0] é o pior dos guardados
+};
+
+TopK *CreateTopK(int k)
+{
+    assert(k > 0);
+    TopK *topk = AllocMemory(MEMORY_SCRATCH, sizeof(TopK));
+    topk->capacity = k;
+    topk->count = 0;
+    topk->heap = AllocMemory(MEMORY_SCRATCH, k * sizeof(Entry));
+
+    return topk;
+}
+
+/**
+ * @brief Verifica se @p a é pior que @p b (menor pontuação; no empate, maior item).
+ */
+static int IsWorse(Entry *a, Entry *b)
+{
+    return a->score < b->score || (a->score == b->score && a->item > b->item);
+}
+
+static void Swap(Entry *a, Entry *b)
+{
+    Entry aux = *a;
+    *a = *b;
+    *b = aux;
+}
+
+static void SiftUp(TopK *topk, int i)
+{
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+
+        if (!IsWorse(&topk->heap[i], &topk->heap[parent]))
+            break;
+
+        Swap(&topk->heap[i], &topk->heap[parent]);
+        i = parent;
+    }
+}
+
+static void SiftDown(TopK *topk, int i)
+{
+    while (1)
+    {
+        int worst = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+
+        if (left < topk->count && IsWorse(&topk->heap[left], &topk->heap[worst]))
+            worst = left;
+
+        if (right < topk->count && IsWorse(&topk->heap[right], &topk->heap[worst]))
+            worst = right;
+
+        if (worst == i)
+            return;
+
+        Swap(&topk->heap[i], &topk->heap[worst]);
+        i = worst;
+    }
+}
+
+void OfferTopK(TopK *topk, int item, long score)
+{
+    assert(topk);
+    Entry entry = {item, score};
+
+    if (topk->count < topk->capacity)
+    {
+        topk->heap[topk->count] = entry;
+        SiftUp(topk, topk->count++);
+        return;
+    }
+
+    // Cheio: só entra quem for melhor que a raiz, que sai.
+    if (!IsWorse(&topk->heap[0], &entry))
+        return;
+
+    topk->heap[0] = entry;
+    SiftDown(topk, 0);
+}
+
+int GetCountTopK(TopK *topk)
+{
+    assert(topk);
+    return topk->count;
+}
+
+int DrainTopK(TopK *topk, int *items, long *scores)
+{
+    assert(topk);
+    assert(items);
+    int count = topk->count;
+
+    // Cada remoção tira o pior: preenche os vetores de trás para frente.
+    for (int i = count - 1; i >= 0; i--)
+    {
+        items[i] = topk->heap[0].item;
+
+        if (scores)
+            scores[i] = topk->heap[0].score;
+
+        topk->heap[0] = topk->heap[--topk->count];
+        SiftDown(topk, 0);
+    }
+
+    return count;
+}
+
+void FreeTopK(TopK *topk)
+{
+    assert(topk);
+    FreeMemory(MEMORY_SCRATCH, topk->heap, topk->capacity * sizeof(Entry));
+    FreeMemory(MEMORY_SCRATCH, topk, sizeof(TopK));
+}
@@ -0,0 +1,65 @@
+/**
+ * @file topk.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the bounded min-heap that keeps the K best-scored items.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+/**
+ * @brief Tipo opaco que guarda os K melhores pares (item, pontuação) oferecidos.
+ *
+ * É um min-heap limitado a K posições: a raiz é o pior dos K melhores, e
+ * cada oferta custa O(log K), de modo que escolher K entre n candidatos
+ * custa O(n log K) sem ordenar todos. Maior pontuação é melhor; no
+ * empate, vence o menor item, para que a resposta seja determinística.
+ * Reservado na memória de rascunho do comando (MEMORY_SCRATCH).
+ */
+typedef struct topk TopK;
+
+/**
+ * @brief Cria um TopK vazio.
+ *
+ * @param k Quantidade máxima de itens guardados (> 0).
+ * @return Ponteiro para o TopK.
+ */
+TopK *CreateTopK(int k);
+
+/**
+ * @brief Oferece um item; ele fica se estiver entre os K melhores até agora.
+ *
+ * @param topk  Ponteiro para o TopK.
+ * @param item  Identificador do item (posição, ID, etc.).
+ * @param score Pontuação do item.
+ */
+void OfferTopK(TopK *topk, int item, long score);
+
+/**
+ * @brief Obtém a quantidade de itens guardados (até K).
+ *
+ * @param topk Ponteiro para o TopK.
+ * @return Quantidade de itens.
+ */
+int GetCountTopK(TopK *topk);
+
+/**
+ * @brief Esvazia o TopK, escrevendo os itens do melhor para o pior.
+ *
+ * @param topk   Ponteiro para o TopK.
+ * @param items  Vetor com espaço para GetCountTopK(topk) itens.
+ * @param scores Vetor com o mesmo espaço, ou NULL se as pontuações não interessarem.
+ * @return Quantidade de itens escritos.
+ */
+int DrainTopK(TopK *topk, int *items, long *scores);
+
+/**
+ * @brief Libera o TopK.
+ *
+ * @param topk Ponteiro para o TopK.
+ */
+void FreeTopK(TopK *topk);
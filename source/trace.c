@@ -0,0 +1,197 @@
+/**
+ * @file trace.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for Chrome trace-event recording.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "trace.h"
+
+typedef struct
+{
+    const char *name;
+    const char *category;
+    long start;
+    long duration;
+    long arg;
+} TraceEvent;
+
+typedef struct traceBuffer TraceBuffer;
+
+struct traceBuffer
+{
+    TraceBuffer *next; // lista global de buffers, só cresce
+    long tid;
+    unsigned long written; // total de eventos gravados (a posição é written % capacidade)
+    TraceEvent events[TRACE_RING_CAPACITY];
+};
+
+static int enabled = 0;
+static char *destination = NULL;
+static long sampleEvery = 1;
+static unsigned long sampleCounter = 0;
+static long origin = 0;
+static TraceBuffer *buffers = NULL;
+static __thread TraceBuffer *localBuffer = NULL;
+
+typedef struct
+{
+    TraceEvent event;
+    long tid;
+} PhaseEvent;
+
+static PhaseEvent phases[TRACE_PHASE_CAPACITY];
+static unsigned long phaseCount = 0; // reservas feitas; as além da capacidade foram descartadas
+
+long NowTrace(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+void InitTrace(void)
+{
+    destination = getenv(TRACE_ENV);
+    enabled = destination && *destination;
+
+    if (!enabled)
+        return;
+
+    char *sample = getenv(TRACE_SAMPLE_ENV);
+    sampleEvery = sample && atol(sample) > 0 ? atol(sample) : 1;
+    origin = NowTrace();
+}
+
+int IsEnabledTrace(void)
+{
+    return enabled;
+}
+
+static TraceBuffer *RegisterBuffer(void)
+{
+    TraceBuffer *buffer = malloc(sizeof(TraceBuffer));
+    assert(buffer);
+    buffer->tid = syscall(SYS_gettid);
+    buffer->written = 0;
+    buffer->next = __atomic_load_n(&buffers, __ATOMIC_RELAXED);
+
+    while (!__atomic_compare_exchange_n(&buffers, &buffer->next, buffer, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        ;
+
+    return buffer;
+}
+
+void RecordTrace(const char *name, const char *category, long start, long arg)
+{
+    if (!enabled)
+        return;
+
+    if (!localBuffer)
+        localBuffer = RegisterBuffer();
+
+    TraceBuffer *buffer = localBuffer;
+    TraceEvent *event = &buffer->events[buffer->written % TRACE_RING_CAPACITY];
+    event->name = name;
+    event->category = category;
+    event->start = start;
+    event->duration = NowTrace() - start;
+    event->arg = arg;
+
+    // Publica o evento só depois de preenchido, para quem ler de outra thread.
+    __atomic_store_n(&buffer->written, buffer->written + 1, __ATOMIC_RELEASE);
+}
+
+void RecordPhaseTrace(const char *name, long start, long arg)
+{
+    if (!enabled)
+        return;
+
+    unsigned long slot = __atomic_fetch_add(&phaseCount, 1, __ATOMIC_RELAXED);
+
+    if (slot >= TRACE_PHASE_CAPACITY)
+        return;
+
+    PhaseEvent *phase = &phases[slot];
+    phase->tid = syscall(SYS_gettid);
+    phase->event.name = name;
+    phase->event.category = "phase";
+    phase->event.start = start;
+    phase->event.duration = NowTrace() - start;
+    phase->event.arg = arg;
+}
+
+static void WriteEvent(FILE *out, int first, TraceEvent *event, long pid, long tid)
+{
+    fprintf(out, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                 "\"pid\":%ld,\"tid\":%ld,\"args\":{\"value\":%ld}}",
+            first ? "" : ",\n", event->name, event->category,
+            (event->start - origin) / 1e3, event->duration / 1e3,
+            pid, tid, event->arg);
+}
+
+int SampleCommandTrace(void)
+{
+    return enabled && __atomic_fetch_add(&sampleCounter, 1, __ATOMIC_RELAXED) % sampleEvery == 0;
+}
+
+void WriteTrace(void)
+{
+    if (!enabled)
+        return;
+
+    enabled = 0;
+    FILE *out = fopen(destination, "w");
+    assert(out);
+    long pid = getpid();
+    int first = 1;
+
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    TraceBuffer *buffer = __atomic_load_n(&buffers, __ATOMIC_ACQUIRE);
+
+    while (buffer)
+    {
+        unsigned long written = __atomic_load_n(&buffer->written, __ATOMIC_ACQUIRE);
+        unsigned long begin = written > TRACE_RING_CAPACITY ? written - TRACE_RING_CAPACITY : 0;
+
+        fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":%ld,\"args\":{\"name\":\"%s\",\"dropped\":%lu}}",
+                first ? "" : ",\n", pid, buffer->tid, buffer->tid == pid ? "main" : "worker", begin);
+        first = 0;
+
+        for (unsigned long i = begin; i < written; i++)
+            WriteEvent(out, 0, &buffer->events[i % TRACE_RING_CAPACITY], pid, buffer->tid);
+
+        TraceBuffer *next = buffer->next;
+        free(buffer);
+        buffer = next;
+    }
+
+    unsigned long recorded = __atomic_load_n(&phaseCount, __ATOMIC_ACQUIRE);
+
+    for (unsigned long i = 0; i < recorded && i < TRACE_PHASE_CAPACITY; i++)
+    {
+        WriteEvent(out, first, &phases[i].event, pid, phases[i].tid);
+        first = 0;
+    }
+
+    if (recorded > TRACE_PHASE_CAPACITY)
+        fprintf(out, "%s{\"name\":\"dropped_phases\",\"ph\":\"i\",\"s\":\"g\",\"ts\":0,\"pid\":%ld,\"tid\":%ld,\"args\":{\"value\":%lu}}",
+                first ? "" : ",\n", pid, pid, recorded - TRACE_PHASE_CAPACITY);
+
+    fprintf(out, "\n]}\n");
+    fclose(out);
+    buffers = NULL;
+    localBuffer = NULL;
+    phaseCount = 0;
+}
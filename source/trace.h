@@ -0,0 +1,104 @@
+/**
+ * @file trace.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for Chrome trace-event recording.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+/**
+ * @def TRACE_ENV
+ * @brief Variável de ambiente com o caminho do arquivo de trace (JSON do Chrome).
+ *
+ * O arquivo pode ser aberto em chrome://tracing ou no Perfetto.
+ */
+#define TRACE_ENV "BOOKED_TRACE"
+
+/**
+ * @def TRACE_SAMPLE_ENV
+ * @brief Variável de ambiente com a taxa de amostragem de comandos.
+ *
+ * Com N, só um a cada N comandos vira evento; fases sempre são gravadas.
+ */
+#define TRACE_SAMPLE_ENV "BOOKED_TRACE_SAMPLE"
+
+/**
+ * @brief Capacidade do buffer circular de cada thread, em eventos.
+ *
+ * Quando enche, os eventos mais antigos daquela thread são sobrescritos;
+ * quantos foram perdidos sai em args.dropped do nome da thread. As fases
+ * não passam por ele (ver RecordPhaseTrace).
+ */
+#define TRACE_RING_CAPACITY (1 << 16)
+
+/**
+ * @brief Capacidade do buffer de fases, que nunca é sobrescrito.
+ *
+ * Cada fase é gravada uma vez por execução; se ainda assim o buffer
+ * encher, as seguintes são descartadas e contadas num evento
+ * "dropped_phases".
+ */
+#define TRACE_PHASE_CAPACITY 256
+
+/**
+ * @brief Liga o trace se TRACE_ENV estiver definida.
+ */
+void InitTrace(void);
+
+/**
+ * @brief Verifica se o trace está ligado.
+ *
+ * @return 1 se ligado, 0 caso contrário.
+ */
+int IsEnabledTrace(void);
+
+/**
+ * @brief Lê o relógio usado nos eventos.
+ *
+ * @return Instante atual em nanossegundos.
+ */
+long NowTrace(void);
+
+/**
+ * @brief Grava um evento completo (início e duração) na thread atual.
+ *
+ * Não usa locks: cada thread escreve apenas no próprio buffer circular,
+ * registrado uma única vez numa lista global por compare-and-swap.
+ *
+ * @param name     Nome do evento (deve viver até o fim do programa).
+ * @param category Categoria do evento (idem).
+ * @param start    Instante de início, obtido por NowTrace.
+ * @param arg      Valor anexado como args.value (ex.: código da operação).
+ */
+void RecordTrace(const char *name, const char *category, long start, long arg);
+
+/**
+ * @brief Grava uma fase (categoria "phase") fora dos buffers circulares.
+ *
+ * Os comandos de uma execução longa não sobrescrevem as fases de carga:
+ * elas ficam num buffer próprio, de TRACE_PHASE_CAPACITY eventos.
+ *
+ * @param name  Nome da fase (deve viver até o fim do programa).
+ * @param start Instante de início, obtido por NowTrace.
+ * @param arg   Valor anexado como args.value (o código da fase).
+ */
+void RecordPhaseTrace(const char *name, long start, long arg);
+
+/**
+ * @brief Decide se o próximo comando deve ser gravado, segundo a amostragem.
+ *
+ * @return 1 se deve ser gravado, 0 caso contrário.
+ */
+int SampleCommandTrace(void);
+
+/**
+ * @brief Escreve todos os buffers no arquivo de trace e desliga o trace.
+ *
+ * Deve ser chamado depois que as demais threads terminaram.
+ */
+void WriteTrace(void);
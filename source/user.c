@@ -18,33 +18,222 @@
 #include "utils.h"
 #include "list.h"
 #include "recommendation.h"
+#include "snapshot.h"
+#include "memory.h"
+#include "bookset.h"
+#include "topk.h"
+#include "minhash.h"
+#include "bookindex.h"
+#include "yearindex.h"
+
+/**
+ * @brief Usuários por bloco do armazenamento denso.
+ *
+ * Os usuários carregados ficam em blocos contíguos que nunca são movidos,
+ * de modo que os User* guardados em listas continuam válidos.
+ */
+#define USERS_PER_CHUNK 256
+
+/**
+ * @brief Bytes reservados para nomes na primeira carga; depois a capacidade dobra.
+ */
+#define USER_INITIAL_NAMES 4096
+
+/**
+ * @brief Palavras do bitset de preferências guardadas no próprio leitor (256 gêneros).
+ *
+ * Catálogos com mais gêneros passam a um bitset reservado à parte, que
+ * cresce com GetCountGenresBook.
+ */
+#define GENRE_INLINE_WORDS 4
+
+#define GENRE_WORD_BITS (8 * (int)sizeof(unsigned long))
 
 struct user
 {
     int id;
-    char *name;
-    int lenPreferences;
-    char **preferences;
-    List *finishedBooks;
-    List *whishedBooks;
-    List *recommendations;
-    List *afinities;
+    int index;
+    unsigned version;
+    unsigned name; // deslocamento no heap de nomes
+    int detached;  // 1 se for uma cópia fora do armazenamento denso (CloneUser)
+    int preferenceWords; // tamanho do bitset de preferências (GENRE_INLINE_WORDS ou mais)
+    union
+    {
+        unsigned long bits[GENRE_INLINE_WORDS];
+        unsigned long *wide; // se preferenceWords > GENRE_INLINE_WORDS
+    } preferences;           // bitset de IDs de gênero (ver InternGenreBook)
+    BookSet finishedBooks;
+    BookSet whishedBooks;
+    unsigned signature[MINHASH_SIZE]; // MinHash dos livros lidos (ver minhash.h)
+    Inbox recommendations;
+    List afinities;
+    int *afinityWeights; // gêneros em comum com cada afinidade, na ordem da lista
+    int weightCapacity;
 };
 
+typedef struct
+{
+    User **chunks;
+    int chunkCount;
+    int count;
+    char *names;
+    size_t namesLength;
+    size_t namesCapacity;
+} UserStore;
+
+/**
+ * @brief Pontuação que marca, no acumulador, um livro que o próprio leitor já tem.
+ */
+#define SUGGESTION_EXCLUDED -1
+
+/**
+ * @brief Acumulador esparso das pontuações de PrintSuggestionsUser.
+ *
+ * Um vetor denso indexado pela posição do livro no catálogo, reservado
+ * uma única vez, mais a lista das posições tocadas na consulta: só elas
+ * são lidas e zeradas depois, então o custo não depende do catálogo.
+ */
+typedef struct
+{
+    int *scores;
+    int *touched;
+    int touchedCount;
+    int capacity;
+} Accumulator;
+
+/**
+ * @brief Vetores das duas buscas de PrintPathUsers, indexados por GetIndexUser.
+ *
+ * Reservados uma vez para todos os leitores; em vez de zerá-los a cada
+ * consulta, cada consulta usa uma nova geração e uma posição só vale se
+ * seu carimbo for a geração atual.
+ */
+typedef struct
+{
+    int capacity;
+    unsigned generation;
+    unsigned *stamp[2];
+    int *depth[2];
+    User **parent[2];
+    User **queue[2];
+} PathSearch;
+
+static UserStore store = {0};
+static Accumulator accumulator = {0};
+static PathSearch search = {0};
+
 void PrintAfinity(void *ptr, int isLast);
 
+static User *UserAt(int position)
+{
+    assert(position >= 0 && position < store.count);
+    return &store.chunks[position / USERS_PER_CHUNK][position % USERS_PER_CHUNK];
+}
+
+static char *NameOf(User *user)
+{
+    return store.names + user->name;
+}
+
+static unsigned PushName(char *name)
+{
+    size_t size = strlen(name) + 1;
+
+    if (store.namesLength + size > store.namesCapacity)
+    {
+        size_t capacity = store.namesCapacity ? store.namesCapacity : USER_INITIAL_NAMES;
+
+        while (store.namesLength + size > capacity)
+            capacity *= 2;
+
+        store.names = ReallocMemory(MEMORY_USER, store.names, store.namesCapacity, capacity);
+        store.namesCapacity = capacity;
+    }
+
+    unsigned offset = (unsigned)store.namesLength;
+    memcpy(store.names + offset, name, size);
+    store.namesLength += size;
+
+    return offset;
+}
+
+static User *NextSlot(void)
+{
+    if (store.count == store.chunkCount * USERS_PER_CHUNK)
+    {
+        store.chunks = ReallocMemory(MEMORY_USER, store.chunks,
+                                     store.chunkCount * sizeof(User *),
+                                     (store.chunkCount + 1) * sizeof(User *));
+        store.chunks[store.chunkCount++] = AllocMemory(MEMORY_USER, USERS_PER_CHUNK * sizeof(User));
+    }
+
+    User *user = &store.chunks[store.count / USERS_PER_CHUNK][store.count % USERS_PER_CHUNK];
+    store.count++;
+
+    return user;
+}
+
+/**
+ * @brief Etiqueta das reservas próprias de um leitor: as cópias de
+ *        snapshot ficam todas em MEMORY_SNAPSHOT, fora das arenas.
+ */
+static int TagOf(User *user, int tag)
+{
+    return user->detached ? MEMORY_SNAPSHOT : tag;
+}
+
+static unsigned long *PreferencesOf(User *user)
+{
+    return user->preferenceWords > GENRE_INLINE_WORDS ? user->preferences.wide : user->preferences.bits;
+}
+
+static void GrowPreferencesUser(User *user, int words)
+{
+    // Já dimensiona para todos os gêneros conhecidos: cresce uma vez por carga, não por gênero.
+    int genreWords = (GetCountGenresBook() + GENRE_WORD_BITS - 1) / GENRE_WORD_BITS;
+    words = words > genreWords ? words : genreWords;
+    unsigned long *wide = CallocMemory(TagOf(user, MEMORY_USER), words, sizeof(unsigned long));
+    memcpy(wide, PreferencesOf(user), user->preferenceWords * sizeof(unsigned long));
+
+    if (user->preferenceWords > GENRE_INLINE_WORDS)
+        FreeMemory(TagOf(user, MEMORY_USER), user->preferences.wide, user->preferenceWords * sizeof(unsigned long));
+
+    user->preferences.wide = wide;
+    user->preferenceWords = words;
+}
+
+static void AddPreferenceUser(User *user, char *genre)
+{
+    int id = InternGenreBook(genre);
+
+    if (id / GENRE_WORD_BITS >= user->preferenceWords)
+        GrowPreferencesUser(user, id / GENRE_WORD_BITS + 1);
+
+    PreferencesOf(user)[id / GENRE_WORD_BITS] |= 1UL << (id % GENRE_WORD_BITS);
+}
+
 User *CreateUser(int id, char *name, int lenPreferences, char **preferences)
 {
-    User *user = malloc(sizeof(User));
-    assert(user);
+    User *user = NextSlot();
     user->id = id;
-    user->name = strdup(name);
-    user->lenPreferences = lenPreferences;
-    user->preferences = preferences;
-    user->finishedBooks = CreateList(PrintBook, CompareIdBook);
-    user->whishedBooks = CreateList(PrintBook, CompareIdBook);
-    user->recommendations = CreateList(PrintRecommendation, CompareIdRecommendation);
-    user->afinities = CreateList(PrintAfinity, CompareIdUser);
+    user->index = -1;
+    user->version = 0;
+    user->name = PushName(name);
+    user->detached = 0;
+    user->preferenceWords = GENRE_INLINE_WORDS;
+    memset(user->preferences.bits, 0, sizeof(user->preferences.bits));
+
+    for (int i = 0; i < lenPreferences; i++)
+        AddPreferenceUser(user, preferences[i]);
+
+    InitBookSet(&user->finishedBooks);
+    InitBookSet(&user->whishedBooks);
+    InitSignatureMinHash(user->signature);
+    InitInbox(&user->recommendations);
+    InitList(&user->afinities, PrintAfinity, CompareIdUser);
+    SetMemoryTagList(&user->afinities, MEMORY_AFFINITY);
+    user->afinityWeights = NULL;
+    user->weightCapacity = 0;
 
     return user;
 }
@@ -60,16 +249,16 @@ User *ReadUser(FILE *file)
         return NULL;
     }
 
-    char **preferences = malloc(lenPreferences * sizeof(char *));
+    User *user = CreateUser(id, name, 0, NULL);
 
     for (int i = 0; i < lenPreferences; i++)
     {
         char preference[MAX_LINE_LENGTH] = "";
         fscanf(file, ";%[^;\n]", preference);
-        preferences[i] = strdup(preference);
+        AddPreferenceUser(user, preference);
     }
 
-    return CreateUser(id, name, lenPreferences, preferences);
+    return user;
 }
 
 int CompareIdUser(void *ptr, va_list args)
@@ -81,22 +270,23 @@ int CompareIdUser(void *ptr, va_list args)
     return user->id == id;
 }
 
-void PrintUser(void *ptr, int)
+void PrintUser(void *ptr, int indent)
 {
+    (void)indent;
     User *user = (User *)ptr;
     assert(user);
-    printf("Leitor: %s\n", user->name);
+    printf("Leitor: %s\n", NameOf(user));
     printf("Lidos: ");
-    PrintList(user->finishedBooks);
+    PrintBookSet(&user->finishedBooks);
     printf("\n");
     printf("Desejados: ");
-    PrintList(user->whishedBooks);
+    PrintBookSet(&user->whishedBooks);
     printf("\n");
     printf("Recomendacoes: ");
-    PrintList(user->recommendations);
+    PrintInbox(&user->recommendations);
     printf("\n");
     printf("Afinidades: ");
-    PrintList(user->afinities);
+    PrintList(&user->afinities);
     printf("\n\n");
 }
 
@@ -104,20 +294,50 @@ void FreeUser(void *ptr)
 {
     User *user = (User *)ptr;
     assert(user);
-    free(user->name);
+    ReleaseBookSet(&user->finishedBooks);
+    ReleaseBookSet(&user->whishedBooks);
+    ReleaseInbox(&user->recommendations);
+    ReleaseList(&user->afinities);
+    FreeMemory(TagOf(user, MEMORY_AFFINITY), user->afinityWeights, user->weightCapacity * sizeof(int));
+    user->afinityWeights = NULL;
+    user->weightCapacity = 0;
+
+    if (user->preferenceWords > GENRE_INLINE_WORDS)
+        FreeMemory(TagOf(user, MEMORY_USER), user->preferences.wide, user->preferenceWords * sizeof(unsigned long));
+
+    user->preferenceWords = GENRE_INLINE_WORDS;
+    memset(user->preferences.bits, 0, sizeof(user->preferences.bits));
+
+    if (user->detached)
+        FreeMemory(MEMORY_SNAPSHOT, user, sizeof(User));
+}
 
-    for (int i = 0; i < user->lenPreferences; i++)
-        free(user->preferences[i]);
+void FreeStoreUsers(void)
+{
+    for (int i = 0; i < store.chunkCount; i++)
+        FreeMemory(MEMORY_USER, store.chunks[i], USERS_PER_CHUNK * sizeof(User));
 
-    free(user->preferences);
+    FreeMemory(MEMORY_USER, store.chunks, store.chunkCount * sizeof(User *));
+    FreeMemory(MEMORY_USER, store.names, store.namesCapacity);
+    memset(&store, 0, sizeof(store));
+    FreeStoreBookSets();
 
-    FreeList(user->finishedBooks);
-    FreeList(user->whishedBooks);
-    ForEach(user->recommendations, free);
-    FreeList(user->recommendations);
-    FreeList(user->afinities);
+    FreeMemory(MEMORY_INDEX, accumulator.scores, accumulator.capacity * sizeof(int));
+    FreeMemory(MEMORY_INDEX, accumulator.touched, accumulator.capacity * sizeof(int));
+    memset(&accumulator, 0, sizeof(accumulator));
+
+    for (int side = 0; side < 2; side++)
+    {
+        FreeMemory(MEMORY_INDEX, search.stamp[side], search.capacity * sizeof(unsigned));
+        FreeMemory(MEMORY_INDEX, search.depth[side], search.capacity * sizeof(int));
+        FreeMemory(MEMORY_INDEX, search.parent[side], search.capacity * sizeof(User *));
+        FreeMemory(MEMORY_INDEX, search.queue[side], search.capacity * sizeof(User *));
+    }
 
-    free(user);
+    memset(&search, 0, sizeof(search));
+    FreeIndexMinHash();
+    FreeBookIndex();
+    FreeYearIndex();
 }
 
 int GetIdUser(void *ptr)
@@ -127,11 +347,76 @@ int GetIdUser(void *ptr)
     return user->id;
 }
 
+int GetIndexUser(void *ptr)
+{
+    User *user = (User *)ptr;
+    assert(user);
+    return user->index;
+}
+
+void SetIndexUser(User *user, int index)
+{
+    assert(user);
+    user->index = index;
+}
+
+unsigned GetVersionUser(User *user)
+{
+    assert(user);
+    return user->version;
+}
+
+User *CloneUser(User *user)
+{
+    assert(user);
+    User *clone = AllocMemory(MEMORY_SNAPSHOT, sizeof(User));
+    clone->id = user->id;
+    clone->index = user->index;
+    clone->version = user->version;
+    clone->name = user->name; // nomes nunca mudam: a cópia compartilha o heap
+    clone->detached = 1;
+    clone->preferenceWords = GENRE_INLINE_WORDS;
+    memset(clone->preferences.bits, 0, sizeof(clone->preferences.bits));
+
+    if (user->preferenceWords > GENRE_INLINE_WORDS)
+        GrowPreferencesUser(clone, user->preferenceWords);
+
+    memcpy(PreferencesOf(clone), PreferencesOf(user), user->preferenceWords * sizeof(unsigned long));
+    InitCopyBookSet(&clone->finishedBooks, &user->finishedBooks, MEMORY_SNAPSHOT);
+    InitCopyBookSet(&clone->whishedBooks, &user->whishedBooks, MEMORY_SNAPSHOT);
+    memcpy(clone->signature, user->signature, sizeof(user->signature));
+    InitCopyInbox(&clone->recommendations, &user->recommendations, MEMORY_SNAPSHOT);
+    InitCopyList(&clone->afinities, &user->afinities, MEMORY_SNAPSHOT);
+    clone->weightCapacity = GetLengthList(&user->afinities);
+    clone->afinityWeights = NULL;
+
+    // Sem afinidades o leitor nem chegou a reservar os pesos.
+    if (clone->weightCapacity)
+    {
+        clone->afinityWeights = AllocMemory(MEMORY_SNAPSHOT, clone->weightCapacity * sizeof(int));
+        memcpy(clone->afinityWeights, user->afinityWeights, clone->weightCapacity * sizeof(int));
+    }
+
+    return clone;
+}
+
 char *GetNameUser(void *ptr)
 {
     User *user = (User *)ptr;
     assert(user);
-    return user->name;
+    return NameOf(user);
+}
+
+BookSet *GetFinishedBooksUser(User *user)
+{
+    assert(user);
+    return &user->finishedBooks;
+}
+
+List *GetAfinitiesUser(User *user)
+{
+    assert(user);
+    return &user->afinities;
 }
 
 int AreCompatibleUsers(User *user1, User *user2)
@@ -139,29 +424,62 @@ int AreCompatibleUsers(User *user1, User *user2)
     assert(user1);
     assert(user2);
 
-    for (int i = 0; i < user1->lenPreferences; i++)
+    unsigned long *preferences1 = PreferencesOf(user1);
+    unsigned long *preferences2 = PreferencesOf(user2);
+    int words = user1->preferenceWords < user2->preferenceWords ? user1->preferenceWords : user2->preferenceWords;
+
+    for (int i = 0; i < words; i++)
     {
-        for (int j = 0; j < user2->lenPreferences; j++)
-        {
-            if (strcmp(user1->preferences[i], user2->preferences[j]) == 0)
-                return 1;
-        }
+        if (preferences1[i] & preferences2[i])
+            return 1;
     }
 
     return 0;
 }
 
+int CountSharedGenresUsers(User *user1, User *user2)
+{
+    assert(user1);
+    assert(user2);
+    unsigned long *preferences1 = PreferencesOf(user1);
+    unsigned long *preferences2 = PreferencesOf(user2);
+    int words = user1->preferenceWords < user2->preferenceWords ? user1->preferenceWords : user2->preferenceWords;
+    int shared = 0;
+
+    for (int i = 0; i < words; i++)
+        shared += __builtin_popcountl(preferences1[i] & preferences2[i]);
+
+    return shared;
+}
+
+static void AppendAfinity(User *user, User *other, int weight)
+{
+    int length = GetLengthList(&user->afinities);
+
+    if (length == user->weightCapacity)
+    {
+        int capacity = user->weightCapacity ? 2 * user->weightCapacity : 8;
+        user->afinityWeights = ReallocMemory(MEMORY_AFFINITY, user->afinityWeights,
+                                             user->weightCapacity * sizeof(int), capacity * sizeof(int));
+        user->weightCapacity = capacity;
+    }
+
+    user->afinityWeights[length] = weight;
+    AppendList(&user->afinities, other);
+}
+
 void ConnectUsers(void *ptr1, void *ptr2)
 {
     User *user1 = (User *)ptr1;
     User *user2 = (User *)ptr2;
     assert(user1);
     assert(user2);
+    int weight = CountSharedGenresUsers(user1, user2);
 
-    if (AreCompatibleUsers(user1, user2))
+    if (weight)
     {
-        AppendList(user1->afinities, user2);
-        AppendList(user2->afinities, user1);
+        AppendAfinity(user1, user2, weight);
+        AppendAfinity(user2, user1, weight);
     }
 }
 
@@ -169,7 +487,7 @@ void PrintAfinity(void *ptr, int isLast)
 {
     User *user = (User *)ptr;
     assert(user);
-    printf("%s", user->name);
+    printf("%s", NameOf(user));
 
     if (!isLast)
     {
@@ -177,94 +495,196 @@ void PrintAfinity(void *ptr, int isLast)
     }
 }
 
-void AddBookToFinishedUser(User *user1, Book *book)
+static void IndexBookUser(int list, User *user, Book *book)
+{
+    // Cópias de snapshot e leitores sem posição não entram no índice.
+    if (user->index < 0 || user->detached)
+        return;
+
+    AddBookIndex(list, GetIndexBook(book), user->index);
+
+    if (list == BOOKINDEX_READERS)
+        AddYearIndex(user->index, book);
+}
+
+int InsertFinishedBookUser(User *user, Book *book)
+{
+    assert(user);
+    assert(book);
+
+    if (ContainsBookSet(&user->finishedBooks, GetIdBook(book)))
+        return 0;
+
+    PreserveUserSnapshot(user);
+
+    if (!AppendBookSet(&user->finishedBooks, book))
+        return 0;
+
+    user->version++;
+
+    IndexBookUser(BOOKINDEX_READERS, user, book);
+
+    if (AddSignatureMinHash(user->signature, GetIdBook(book)) && user->index >= 0)
+        IndexMinHash(user->index, user->signature);
+
+    return 1;
+}
+
+int InsertWishedBookUser(User *user, Book *book)
+{
+    assert(user);
+    assert(book);
+
+    if (ContainsBookSet(&user->whishedBooks, GetIdBook(book)))
+        return 0;
+
+    PreserveUserSnapshot(user);
+
+    if (!AppendBookSet(&user->whishedBooks, book))
+        return 0;
+
+    user->version++;
+    IndexBookUser(BOOKINDEX_WISHERS, user, book);
+    return 1;
+}
+
+int InsertRecommendationUser(User *user1, Book *book, User *user2)
 {
     assert(user1);
+    assert(user2);
     assert(book);
 
-    if (!FindList(user1->finishedBooks, GetIdBook(book)))
+    if (ContainsBookSet(&user2->whishedBooks, GetIdBook(book)))
+        return RECOMMENDATION_ALREADY_WISHED;
+
+    if (ContainsBookSet(&user2->finishedBooks, GetIdBook(book)))
+        return RECOMMENDATION_ALREADY_FINISHED;
+
+    PreserveUserSnapshot(user2);
+    PushInbox(&user2->recommendations, CreateRecommendation(book, user1));
+    user2->version++;
+    return RECOMMENDATION_INSERTED;
+}
+
+Book *TakeRecommendationUser(User *user1, int idBook, User *user2)
+{
+    assert(user1);
+    assert(user2);
+
+    // Só preserva se houver o que retirar: aceitar ou recusar o que não existe não copia o usuário.
+    if (!FindInbox(&user1->recommendations, idBook, user2->id))
+        return NULL;
+
+    PreserveUserSnapshot(user1);
+    Recommendation *recommendation = TakeInbox(&user1->recommendations, idBook, user2->id);
+    assert(recommendation);
+
+    Book *book = GetBookRecommendation(recommendation);
+    FreeRecommendation(recommendation);
+    user1->version++;
+
+    return book;
+}
+
+Book *AcceptRecommendationUser(User *user1, int idBook, User *user2)
+{
+    Book *book = TakeRecommendationUser(user1, idBook, user2);
+
+    if (book)
     {
-        printf("%s leu \"%s\"\n", user1->name, GetTitleBook(book));
-        AppendList(user1->finishedBooks, book);
-        return;
+        // A lista de desejos aceita repetições; o índice reverso, não.
+        int wished = ContainsBookSet(&user1->whishedBooks, GetIdBook(book));
+
+        if (AppendBookSet(&user1->whishedBooks, book) && !wished)
+            IndexBookUser(BOOKINDEX_WISHERS, user1, book);
+
+        user1->version++;
     }
 
-    printf("%s já leu \"%s\"\n", user1->name, GetTitleBook(book));
+    return book;
 }
 
-void AddBookToWishedUser(User *user1, Book *book)
+int AddBookToFinishedUser(User *user1, Book *book)
 {
     assert(user1);
     assert(book);
 
-    if (!FindList(user1->whishedBooks, GetIdBook(book)))
+    if (InsertFinishedBookUser(user1, book))
     {
-        printf("%s deseja ler \"%s\"\n", user1->name, GetTitleBook(book));
-        AppendList(user1->whishedBooks, book);
-        return;
+        printf("%s leu \"%s\"\n", NameOf(user1), GetTitleBook(book));
+        return 1;
     }
 
-    printf("%s já deseja ler \"%s\"\n", user1->name, GetTitleBook(book));
+    printf("%s já leu \"%s\"\n", NameOf(user1), GetTitleBook(book));
+    return 0;
 }
 
-void AddBookToRecommendedUser(User *user1, Book *book, User *user2)
+int AddBookToWishedUser(User *user1, Book *book)
 {
     assert(user1);
-    assert(user2);
     assert(book);
 
-    if (FindList(user2->whishedBooks, GetIdBook(book)))
+    if (InsertWishedBookUser(user1, book))
     {
-        printf("%s já deseja ler \"%s\", recomendação desnecessária\n", user2->name, GetTitleBook(book));
-        return;
+        printf("%s deseja ler \"%s\"\n", NameOf(user1), GetTitleBook(book));
+        return 1;
     }
 
-    if (!FindList(user2->finishedBooks, GetIdBook(book)))
+    printf("%s já deseja ler \"%s\"\n", NameOf(user1), GetTitleBook(book));
+    return 0;
+}
+
+int AddBookToRecommendedUser(User *user1, Book *book, User *user2)
+{
+    assert(user1);
+    assert(user2);
+    assert(book);
+
+    switch (InsertRecommendationUser(user1, book, user2))
     {
-        printf("%s recomenda \"%s\" para %s\n", user1->name, GetTitleBook(book), user2->name);
-        Recommendation *recommendation = CreateRecommendation(book, user1);
-        AppendList(user2->recommendations, recommendation);
-        return;
+    case RECOMMENDATION_ALREADY_WISHED:
+        printf("%s já deseja ler \"%s\", recomendação desnecessária\n", NameOf(user2), GetTitleBook(book));
+        return 0;
+
+    case RECOMMENDATION_ALREADY_FINISHED:
+        printf("%s não precisa da recomendação de \"%s\" pois já leu este livro\n", NameOf(user2), GetTitleBook(book));
+        return 0;
     }
 
-    printf("%s não precisa da recomendação de \"%s\" pois já leu este livro\n", user2->name, GetTitleBook(book));
+    printf("%s recomenda \"%s\" para %s\n", NameOf(user1), GetTitleBook(book), NameOf(user2));
+    return 1;
 }
 
-void AcceptRecommendedBook(User *user1, int idBook, User *user2)
+int AcceptRecommendedBook(User *user1, int idBook, User *user2)
 {
     assert(user1);
     assert(user2);
-    Recommendation *recommendation = NULL;
+    Book *book = NULL;
 
-    if ((recommendation = FindList(user1->recommendations, idBook, user2->id)))
+    if ((book = AcceptRecommendationUser(user1, idBook, user2)))
     {
-        Book *book = GetBookRecommendation(recommendation);
-        printf("%s aceita recomendação \"%s\" de %s\n", user1->name, GetTitleBook(book), user2->name);
-        AppendList(user1->whishedBooks, book);
-        RemoveList(user1->recommendations, idBook, user2->id);
-        free(recommendation);
-        return;
+        printf("%s aceita recomendação \"%s\" de %s\n", NameOf(user1), GetTitleBook(book), NameOf(user2));
+        return 1;
     }
 
-    printf("%s não possui recomendação do livro ID %d feita por %s\n", user1->name, idBook, user2->name);
+    printf("%s não possui recomendação do livro ID %d feita por %s\n", NameOf(user1), idBook, NameOf(user2));
+    return 0;
 }
 
-void DenyRecommendedBook(User *user1, int idBook, User *user2)
+int DenyRecommendedBook(User *user1, int idBook, User *user2)
 {
     assert(user1);
     assert(user2);
-    Recommendation *recommendation = NULL;
+    Book *book = NULL;
 
-    if ((recommendation = FindList(user1->recommendations, idBook, user2->id)))
+    if ((book = TakeRecommendationUser(user1, idBook, user2)))
     {
-        Book *book = GetBookRecommendation(recommendation);
-        printf("%s rejeita recomendação \"%s\" de %s\n", user1->name, GetTitleBook(book), user2->name);
-        RemoveList(user1->recommendations, idBook, user2->id);
-        free(recommendation);
-        return;
+        printf("%s rejeita recomendação \"%s\" de %s\n", NameOf(user1), GetTitleBook(book), NameOf(user2));
+        return 1;
     }
 
-    printf("%s não possui recomendação do livro ID %d feita por %s\n", user1->name, idBook, user2->name);
+    printf("%s não possui recomendação do livro ID %d feita por %s\n", NameOf(user1), idBook, NameOf(user2));
+    return 0;
 }
 
 // corrigir depois
@@ -273,10 +693,9 @@ void PrintSharedBooksUsers(User *user1, User *user2)
     assert(user1);
     assert(user2);
 
-    printf("Livros em comum entre %s e %s: ", user1->name, user2->name);
+    printf("Livros em comum entre %s e %s: ", NameOf(user1), NameOf(user2));
 
-    // linha terrivelmente longa, desculpa.
-    List *sharedBooks = GetCommonItemsList(user1->finishedBooks, user2->finishedBooks, CompareIdBook, PrintBook, CompareBooks);
+    List *sharedBooks = GetCommonBookSet(&user1->finishedBooks, &user2->finishedBooks);
 
     if (IsEmptyList(sharedBooks))
         printf("Nenhum livro em comum");
@@ -288,6 +707,96 @@ void PrintSharedBooksUsers(User *user1, User *user2)
     FreeList(sharedBooks);
 }
 
+static void GrowAccumulator(void)
+{
+    int capacity = GetCountBooks();
+
+    if (capacity <= accumulator.capacity)
+        return;
+
+    accumulator.scores = ReallocMemory(MEMORY_INDEX, accumulator.scores,
+                                       accumulator.capacity * sizeof(int), capacity * sizeof(int));
+    accumulator.touched = ReallocMemory(MEMORY_INDEX, accumulator.touched,
+                                        accumulator.capacity * sizeof(int), capacity * sizeof(int));
+    memset(accumulator.scores + accumulator.capacity, 0, (capacity - accumulator.capacity) * sizeof(int));
+    accumulator.capacity = capacity;
+}
+
+static void ExcludeBook(Book *book, void *context)
+{
+    (void)context;
+    int index = GetIndexBook(book);
+
+    if (!accumulator.scores[index])
+        accumulator.touched[accumulator.touchedCount++] = index;
+
+    accumulator.scores[index] = SUGGESTION_EXCLUDED;
+}
+
+static void ScoreBook(Book *book, void *context)
+{
+    (void)context;
+    int index = GetIndexBook(book);
+    int score = accumulator.scores[index];
+
+    if (score == SUGGESTION_EXCLUDED)
+        return;
+
+    if (!score)
+        accumulator.touched[accumulator.touchedCount++] = index;
+
+    accumulator.scores[index] = score + 1;
+}
+
+void PrintSuggestionsUser(User *user, int k)
+{
+    assert(user);
+    assert(k > 0);
+    GrowAccumulator();
+
+    // Os livros do próprio leitor entram primeiro, já excluídos.
+    ForEachBookSet(&user->finishedBooks, ExcludeBook, NULL);
+    ForEachBookSet(&user->whishedBooks, ExcludeBook, NULL);
+
+    for (ListCursor cursor = BeginList(&user->afinities); !IsEndCursor(&cursor); NextCursor(&cursor))
+    {
+        User *neighbor = GetValueCursor(&cursor);
+        ForEachBookSet(&neighbor->finishedBooks, ScoreBook, NULL);
+    }
+
+    TopK *topk = CreateTopK(k);
+
+    for (int i = 0; i < accumulator.touchedCount; i++)
+    {
+        int index = accumulator.touched[i];
+
+        if (accumulator.scores[index] > 0)
+            OfferTopK(topk, index, accumulator.scores[index]);
+
+        accumulator.scores[index] = 0;
+    }
+
+    accumulator.touchedCount = 0;
+
+    int count = GetCountTopK(topk);
+    int *indexes = AllocMemory(MEMORY_SCRATCH, count * sizeof(int));
+    long *scores = AllocMemory(MEMORY_SCRATCH, count * sizeof(long));
+    DrainTopK(topk, indexes, scores);
+    FreeTopK(topk);
+
+    printf("Sugestões para %s: ", NameOf(user));
+
+    if (!count)
+        printf("Nenhuma sugestão");
+
+    for (int i = 0; i < count; i++)
+        printf("%s (%ld)%s", GetTitleBook(GetByIndexBook(indexes[i])), scores[i], i < count - 1 ? ", " : "");
+
+    printf("\n");
+    FreeMemory(MEMORY_SCRATCH, indexes, count * sizeof(int));
+    FreeMemory(MEMORY_SCRATCH, scores, count * sizeof(long));
+}
+
 int SearchUser(User *user, int id, List *visited)
 {
     assert(user);
@@ -305,20 +814,12 @@ int SearchUser(User *user, int id, List *visited)
     if (user->id == id)
         return 1;
 
-    // Inicia a busca nos filhos do nó atual:
-    Cell *currentCell = GetFirstCellList(user->afinities);
-
-    // Loop que percorre os irmaos
-    while (currentCell != NULL)
+    // Inicia a busca nos filhos do nó atual, percorrendo os irmãos:
+    for (ListCursor cursor = BeginList(&user->afinities); !IsEndCursor(&cursor); NextCursor(&cursor))
     {
-        User *currentUser = GetValue(currentCell);
-
         // Busca recursivamente até encontrar o usuário ou chegar ao fim do ramo.
-        if (SearchUser(currentUser, id, visited))
+        if (SearchUser(GetValueCursor(&cursor), id, visited))
             return 1;
-
-        // Passa para o nó irmão e continua a busca.
-        currentCell = GetNext(currentCell);
     }
     // Acabaram os nós irmãos
 
@@ -330,7 +831,7 @@ int AreRelatedUsers(User *user1, User *user2)
     assert(user1);
     assert(user2);
 
-    List *visitedUsers = CreateList(PrintUser, CompareIdUser);
+    List *visitedUsers = CreateScratchList(PrintUser, CompareIdUser);
 
     int result = SearchUser(user1, user2->id, visitedUsers);
 
@@ -338,3 +839,279 @@ int AreRelatedUsers(User *user1, User *user2)
 
     return result;
 }
+
+static void GrowPathSearch(void)
+{
+    int capacity = store.count;
+
+    if (capacity <= search.capacity)
+        return;
+
+    for (int side = 0; side < 2; side++)
+    {
+        search.stamp[side] = ReallocMemory(MEMORY_INDEX, search.stamp[side],
+                                           search.capacity * sizeof(unsigned), capacity * sizeof(unsigned));
+        search.depth[side] = ReallocMemory(MEMORY_INDEX, search.depth[side],
+                                           search.capacity * sizeof(int), capacity * sizeof(int));
+        search.parent[side] = ReallocMemory(MEMORY_INDEX, search.parent[side],
+                                            search.capacity * sizeof(User *), capacity * sizeof(User *));
+        search.queue[side] = ReallocMemory(MEMORY_INDEX, search.queue[side],
+                                           search.capacity * sizeof(User *), capacity * sizeof(User *));
+        memset(search.stamp[side] + search.capacity, 0, (capacity - search.capacity) * sizeof(unsigned));
+    }
+
+    search.capacity = capacity;
+}
+
+static int IsSeen(int side, User *user)
+{
+    return search.stamp[side][user->index] == search.generation;
+}
+
+static void See(int side, User *user, User *parent, int depth)
+{
+    search.stamp[side][user->index] = search.generation;
+    search.parent[side][user->index] = parent;
+    search.depth[side][user->index] = depth;
+}
+
+/**
+ * @brief Imprime a cadeia de pais de @p user até a origem do lado @p side.
+ *
+ * O lado 0 é impresso da origem até @p user; o lado 1, de @p user até o destino.
+ */
+static void PrintChain(int side, User *user)
+{
+    if (side == 0)
+    {
+        User *parent = search.parent[0][user->index];
+
+        if (parent)
+        {
+            PrintChain(0, parent);
+            printf(" -> ");
+        }
+
+        printf("%s", NameOf(user));
+        return;
+    }
+
+    for (User *cur = user; cur; cur = search.parent[1][cur->index])
+        printf(" -> %s", NameOf(cur));
+}
+
+void PrintPathUsers(User *user1, User *user2)
+{
+    assert(user1);
+    assert(user2);
+    assert(user1->index >= 0 && user2->index >= 0);
+    GrowPathSearch();
+
+    if (!++search.generation)
+    {
+        // A geração deu a volta: carimbos antigos poderiam parecer atuais.
+        for (int side = 0; side < 2; side++)
+            memset(search.stamp[side], 0, search.capacity * sizeof(unsigned));
+
+        search.generation = 1;
+    }
+
+    int head[2] = {0, 0};
+    int tail[2] = {1, 1};
+    search.queue[0][0] = user1;
+    search.queue[1][0] = user2;
+    See(0, user1, NULL, 0);
+    See(1, user2, NULL, 0);
+
+    User *meet[2] = {NULL, NULL}; // meet[0] visto pelo lado 0, meet[1] pelo lado 1
+    int best = user1 == user2 ? 0 : -1;
+
+    if (!best)
+        meet[0] = user1;
+
+    while (best < 0 && head[0] < tail[0] && head[1] < tail[1])
+    {
+        // Expande um nível inteiro do lado com a menor fronteira.
+        int side = tail[0] - head[0] <= tail[1] - head[1] ? 0 : 1;
+        int other = !side;
+        int levelEnd = tail[side];
+
+        while (head[side] < levelEnd)
+        {
+            User *user = search.queue[side][head[side]++];
+            int depth = search.depth[side][user->index];
+
+            for (ListCursor cursor = BeginList(&user->afinities); !IsEndCursor(&cursor); NextCursor(&cursor))
+            {
+                User *neighbor = GetValueCursor(&cursor);
+
+                if (IsSeen(other, neighbor))
+                {
+                    // Encontros no mesmo nível podem ter comprimentos diferentes:
+                    // guarda o menor e só para no fim do nível.
+                    int length = depth + 1 + search.depth[other][neighbor->index];
+
+                    if (best < 0 || length < best)
+                    {
+                        best = length;
+                        meet[side] = user;
+                        meet[other] = neighbor;
+                    }
+                }
+
+                if (IsSeen(side, neighbor))
+                    continue;
+
+                See(side, neighbor, user, depth + 1);
+                search.queue[side][tail[side]++] = neighbor;
+            }
+        }
+    }
+
+    if (best < 0)
+    {
+        printf("Não existe caminho entre %s e %s\n", NameOf(user1), NameOf(user2));
+        return;
+    }
+
+    printf("Caminho entre %s e %s: ", NameOf(user1), NameOf(user2));
+    PrintChain(0, meet[0]);
+
+    if (meet[1])
+        PrintChain(1, meet[1]);
+
+    printf("\n");
+}
+
+typedef struct
+{
+    User *user;
+    TopK *topk;
+} SimilarContext;
+
+static void RankCandidate(int position, void *context)
+{
+    SimilarContext *similar = context;
+    User *candidate = UserAt(position);
+    OfferTopK(similar->topk, position, CompareSignatureMinHash(similar->user->signature, candidate->signature));
+}
+
+void PrintSimilarUsers(User *user, int k)
+{
+    assert(user);
+    assert(k > 0);
+
+    SimilarContext similar = {user, CreateTopK(k)};
+    ForEachCandidateMinHash(user->index, user->signature, RankCandidate, &similar);
+
+    int count = GetCountTopK(similar.topk);
+    int *positions = AllocMemory(MEMORY_SCRATCH, count * sizeof(int));
+    long *equal = AllocMemory(MEMORY_SCRATCH, count * sizeof(long));
+    DrainTopK(similar.topk, positions, equal);
+    FreeTopK(similar.topk);
+
+    printf("Leitores parecidos com %s: ", NameOf(user));
+
+    if (!count)
+        printf("Nenhum leitor parecido");
+
+    for (int i = 0; i < count; i++)
+        printf("%s (%ld%%)%s", NameOf(UserAt(positions[i])), equal[i] * 100 / MINHASH_SIZE, i < count - 1 ? ", " : "");
+
+    printf("\n");
+    FreeMemory(MEMORY_SCRATCH, positions, count * sizeof(int));
+    FreeMemory(MEMORY_SCRATCH, equal, count * sizeof(long));
+}
+
+static void PrintBookIndexUsers(int list, Book *book, char *title, char *empty)
+{
+    int *positions = NULL;
+    int count = GetBookIndex(list, GetIndexBook(book), &positions);
+
+    printf("%s \"%s\": ", title, GetTitleBook(book));
+
+    if (!count)
+        printf("%s", empty);
+
+    for (int i = 0; i < count; i++)
+        printf("%s%s", NameOf(UserAt(positions[i])), i < count - 1 ? ", " : "");
+
+    printf("\n");
+}
+
+void PrintReadersBookUsers(Book *book)
+{
+    assert(book);
+    PrintBookIndexUsers(BOOKINDEX_READERS, book, "Leitores de", "Nenhum leitor");
+}
+
+void PrintWishersBookUsers(Book *book)
+{
+    assert(book);
+    PrintBookIndexUsers(BOOKINDEX_WISHERS, book, "Interessados em", "Nenhum interessado");
+}
+
+static void CountMarkedBook(Book *book, void *context)
+{
+    *(int *)context += accumulator.scores[GetIndexBook(book)] == SUGGESTION_EXCLUDED;
+}
+
+void PrintNearestUsers(User *user, int k, int withBooks)
+{
+    assert(user);
+    assert(k > 0);
+
+    // Com livros: os lidos do leitor ficam marcados no acumulador de
+    // PrintSuggestionsUser e cada vizinho conta quantos dos seus caem neles.
+    if (withBooks)
+    {
+        GrowAccumulator();
+        ForEachBookSet(&user->finishedBooks, ExcludeBook, NULL);
+    }
+
+    TopK *topk = CreateTopK(k);
+    int position = 0;
+
+    for (ListCursor cursor = BeginList(&user->afinities); !IsEndCursor(&cursor); NextCursor(&cursor), position++)
+    {
+        User *neighbor = GetValueCursor(&cursor);
+        int weight = user->afinityWeights[position];
+
+        if (withBooks)
+            ForEachBookSet(&neighbor->finishedBooks, CountMarkedBook, &weight);
+
+        OfferTopK(topk, neighbor->index, weight);
+    }
+
+    for (int i = 0; i < accumulator.touchedCount; i++)
+        accumulator.scores[accumulator.touched[i]] = 0;
+
+    accumulator.touchedCount = 0;
+
+    int count = GetCountTopK(topk);
+    int *positions = AllocMemory(MEMORY_SCRATCH, count * sizeof(int));
+    long *weights = AllocMemory(MEMORY_SCRATCH, count * sizeof(long));
+    DrainTopK(topk, positions, weights);
+    FreeTopK(topk);
+
+    printf("Afinidades mais fortes de %s: ", NameOf(user));
+
+    if (!count)
+        printf("Nenhuma afinidade");
+
+    for (int i = 0; i < count; i++)
+        printf("%s (%ld)%s", NameOf(UserAt(positions[i])), weights[i], i < count - 1 ? ", " : "");
+
+    printf("\n");
+    FreeMemory(MEMORY_SCRATCH, positions, count * sizeof(int));
+    FreeMemory(MEMORY_SCRATCH, weights, count * sizeof(long));
+}
+
+void PrintYearCountUser(User *user, int from, int to)
+{
+    assert(user);
+    assert(user->index >= 0 && !user->detached);
+    int count = CountFinishedYearIndex(user->index, &user->finishedBooks, from, to);
+
+    printf("%s leu %d livros publicados de %d a %d\n", NameOf(user), count, from, to);
+}
@@ -13,6 +13,7 @@
 
 #include "book.h"
 #include "list.h"
+#include "bookset.h"
 
 /**
  * @def USER_SOURCE_FILE
@@ -27,19 +28,28 @@
 
 /**
  * @brief Tipo opaco que representa um usuário.
+ *
+ * Os usuários carregados ficam num armazenamento denso (blocos contíguos
+ * que nunca se movem), com os nomes num único heap de strings, as
+ * preferências como bitset de IDs de gênero e as listas embutidas na
+ * própria struct: carregar um leitor não faz nenhuma alocação própria.
+ * Os livros lidos e desejados são BookSets, que podem ficar num arquivo
+ * de páginas em vez da memória (ver bookset.h).
  */
 typedef struct user User;
 
 /**
  * @brief Cria um novo usuário.
  *
- * Aloca e inicializa um objeto User com ID, nome e preferências.
+ * Ocupa a próxima posição do armazenamento denso e inicializa o User
+ * com ID, nome e preferências. Nome e preferências são copiados; os
+ * gêneros são internados no catálogo (ver InternGenreBook).
  *
  * @param id              Identificador único do usuário.
  * @param name            Nome completo do usuário (string NUL-terminated).
  * @param lenPreferences  Quantidade de preferências em @p preferences.
  * @param preferences     Vetor de strings com preferências literárias.
- * @return Ponteiro para o novo User, ou NULL em falha de alocação.
+ * @return Ponteiro para o novo User (válido até FreeStoreUsers).
  */
 User *CreateUser(int id,
                  char *name,
@@ -83,12 +93,22 @@ void PrintUser(void *userPtr, int indent);
 /**
  * @brief Libera toda a memória associada a um User.
  *
- * Desaloca listas internas, strings e a própria estrutura.
+ * Desaloca as células das listas internas e as recomendações. A própria
+ * estrutura só é liberada se for uma cópia (CloneUser); as demais
+ * pertencem ao armazenamento denso (ver FreeStoreUsers).
  *
  * @param userPtr Ponteiro genérico para User.
  */
 void FreeUser(void *userPtr);
 
+/**
+ * @brief Libera o armazenamento denso, o heap de nomes e o arquivo de
+ *        conjuntos de livros (ver BOOKSET_STORE_ENV).
+ *
+ * Deve ser chamado no final, depois de FreeUser em todos os usuários.
+ */
+void FreeStoreUsers(void);
+
 /**
  * @brief Obtém o ID de um usuário.
  *
@@ -97,6 +117,49 @@ void FreeUser(void *userPtr);
  */
 int GetIdUser(void *ptr);
 
+/**
+ * @brief Obtém a posição densa do usuário (ordem de carregamento).
+ *
+ * @param ptr Ponteiro genérico para User.
+ * @return Índice do usuário em [0, quantidade de usuários).
+ */
+int GetIndexUser(void *ptr);
+
+/**
+ * @brief Define a posição densa do usuário.
+ *
+ * Chamado uma única vez no carregamento, na ordem de leitores.txt.
+ *
+ * @param user  Ponteiro para User.
+ * @param index Posição do usuário na lista de usuários.
+ */
+void SetIndexUser(User *user, int index);
+
+/**
+ * @brief Obtém a versão do estado do usuário.
+ *
+ * A versão é incrementada a cada mutação de lidos, desejados ou
+ * recomendações, e permite verificar se um estado mudou desde um snapshot.
+ *
+ * @param user Ponteiro para User.
+ * @return Versão atual.
+ */
+unsigned GetVersionUser(User *user);
+
+/**
+ * @brief Cria uma cópia independente do usuário.
+ *
+ * Copia preferências e listas (as recomendações são duplicadas; nome,
+ * livros e afinidades são compartilhados). A cópia fica fora do
+ * armazenamento denso e deve ser liberada com FreeUser. Tudo o que ela
+ * reserva sai de MEMORY_SNAPSHOT, fora das arenas, e volta ao sistema
+ * nesse FreeUser, não só no fim da execução.
+ *
+ * @param user Ponteiro para User a ser copiado.
+ * @return Ponteiro para a cópia.
+ */
+User *CloneUser(User *user);
+
 /**
  * @brief Obtém o nome de um usuário.
  *
@@ -105,6 +168,22 @@ int GetIdUser(void *ptr);
  */
 char *GetNameUser(void *ptr);
 
+/**
+ * @brief Obtém o conjunto de livros lidos de um usuário (somente leitura).
+ *
+ * @param user Ponteiro para User.
+ * @return Ponteiro para o BookSet embutido no User.
+ */
+BookSet *GetFinishedBooksUser(User *user);
+
+/**
+ * @brief Obtém a lista de afinidades de um usuário (somente leitura).
+ *
+ * @param user Ponteiro para User.
+ * @return Ponteiro para a List de User* embutida no User.
+ */
+List *GetAfinitiesUser(User *user);
+
 /**
  * @brief Registra afinidade entre dois usuários.
  *
@@ -123,16 +202,18 @@ void ConnectUsers(void *ptr1, void *ptr2);
  *
  * @param user1 Ponteiro para User que leu o livro.
  * @param book  Ponteiro para Book lido.
+ * @return 1 se o estado do usuário foi alterado, 0 caso contrário.
  */
-void AddBookToFinishedUser(User *user1, Book *book);
+int AddBookToFinishedUser(User *user1, Book *book);
 
 /**
  * @brief Adiciona um livro à lista de desejos de um usuário.
  *
  * @param user1 Ponteiro para User que deseja o livro.
  * @param book  Ponteiro para Book desejado.
+ * @return 1 se o estado do usuário foi alterado, 0 caso contrário.
  */
-void AddBookToWishedUser(User *user1, Book *book);
+int AddBookToWishedUser(User *user1, Book *book);
 
 /**
  * @brief Registra recomendação de livro entre usuários.
@@ -140,10 +221,11 @@ void AddBookToWishedUser(User *user1, Book *book);
  * @param user1 Ponteiro para User que recomenda.
  * @param book  Ponteiro para Book recomendado.
  * @param user2 Ponteiro para User que recebe a recomendação.
+ * @return 1 se o estado do usuário foi alterado, 0 caso contrário.
  */
-void AddBookToRecommendedUser(User *user1,
-                              Book *book,
-                              User *user2);
+int AddBookToRecommendedUser(User *user1,
+                             Book *book,
+                             User *user2);
 
 /**
  * @brief Aceita recomendação de livro pendente.
@@ -151,10 +233,11 @@ void AddBookToRecommendedUser(User *user1,
  * @param user1   Ponteiro para User que aceita a recomendação.
  * @param idBook  ID do Book aceito.
  * @param user2   Ponteiro para User que fez a recomendação.
+ * @return 1 se o estado do usuário foi alterado, 0 caso contrário.
  */
-void AcceptRecommendedBook(User *user1,
-                           int idBook,
-                           User *user2);
+int AcceptRecommendedBook(User *user1,
+                          int idBook,
+                          User *user2);
 
 /**
  * @brief Nega recomendação de livro pendente.
@@ -162,10 +245,72 @@ void AcceptRecommendedBook(User *user1,
  * @param user1   Ponteiro para User que nega a recomendação.
  * @param idBook  ID do Book negado.
  * @param user2   Ponteiro para User que fez a recomendação.
+ * @return 1 se o estado do usuário foi alterado, 0 caso contrário.
+ */
+int DenyRecommendedBook(User *user1,
+                        int idBook,
+                        User *user2);
+
+/**
+ * @brief Insere um livro nos lidos do usuário, sem imprimir nada.
+ *
+ * Núcleo de AddBookToFinishedUser, usado também na reaplicação do journal.
+ *
+ * @param user Ponteiro para User.
+ * @param book Ponteiro para Book.
+ * @return 1 se inserido, 0 se o livro já constava como lido.
+ */
+int InsertFinishedBookUser(User *user, Book *book);
+
+/**
+ * @brief Insere um livro nos desejados do usuário, sem imprimir nada.
+ *
+ * @param user Ponteiro para User.
+ * @param book Ponteiro para Book.
+ * @return 1 se inserido, 0 se o livro já constava como desejado.
+ */
+int InsertWishedBookUser(User *user, Book *book);
+
+/**
+ * @brief Códigos de retorno de InsertRecommendationUser.
+ */
+#define RECOMMENDATION_INSERTED 1
+#define RECOMMENDATION_ALREADY_WISHED 2
+#define RECOMMENDATION_ALREADY_FINISHED 3
+
+/**
+ * @brief Entrega uma recomendação de @p user1 para @p user2, sem imprimir nada.
+ *
+ * @param user1 Ponteiro para User que recomenda.
+ * @param book  Ponteiro para Book recomendado.
+ * @param user2 Ponteiro para User que recebe a recomendação.
+ * @return Um dos códigos RECOMMENDATION_*.
+ */
+int InsertRecommendationUser(User *user1, Book *book, User *user2);
+
+/**
+ * @brief Retira uma recomendação pendente, sem imprimir nada.
+ *
+ * Libera a Recommendation e devolve o livro que ela carregava.
+ *
+ * @param user1  Ponteiro para User que recebeu a recomendação.
+ * @param idBook ID do livro recomendado.
+ * @param user2  Ponteiro para User que fez a recomendação.
+ * @return Book da recomendação removida, ou NULL se não havia nenhuma.
+ */
+Book *TakeRecommendationUser(User *user1, int idBook, User *user2);
+
+/**
+ * @brief Aceita uma recomendação pendente, sem imprimir nada.
+ *
+ * Retira a recomendação e acrescenta o livro aos desejados de @p user1.
+ *
+ * @param user1  Ponteiro para User que aceita a recomendação.
+ * @param idBook ID do livro recomendado.
+ * @param user2  Ponteiro para User que fez a recomendação.
+ * @return Book aceito, ou NULL se não havia recomendação.
  */
-void DenyRecommendedBook(User *user1,
-                         int idBook,
-                         User *user2);
+Book *AcceptRecommendationUser(User *user1, int idBook, User *user2);
 
 /**
  * @brief Exibe livros compartilhados entre dois usuários.
@@ -182,4 +327,138 @@ void PrintSharedBooksUsers(User *user1, User *user2);
  * @param user2 Ponteiro para o segundo User.
  * @return !=0 se existe afinidade, 0 caso contrário.
  */
-int AreRelatedUsers(User *user1, User *user2);
\ No newline at end of file
+int AreRelatedUsers(User *user1, User *user2);
+
+/**
+ * @brief Conta os gêneros preferidos em comum entre dois usuários.
+ *
+ * É o peso da afinidade entre eles (0 = sem afinidade), calculado pelo
+ * popcount do AND dos bitsets de preferências.
+ *
+ * @param user1 Ponteiro para o primeiro User.
+ * @param user2 Ponteiro para o segundo User.
+ * @return Quantidade de gêneros em comum.
+ */
+int CountSharedGenresUsers(User *user1, User *user2);
+
+/**
+ * @brief Imprime os @p k leitores com as afinidades mais fortes com @p user.
+ *
+ * O peso de cada afinidade (gêneros em comum) é guardado junto da lista
+ * quando o grafo é construído; com @p withBooks, soma-se a quantidade de
+ * livros lidos em comum, calculada na hora. Os K maiores saem de um
+ * min-heap limitado (seleção parcial, sem ordenar todos os vizinhos).
+ * O grafo de afinidades já deve estar construído.
+ *
+ * Formato:
+ * @verbatim
+ * Afinidades mais fortes de <nome>: <nome> (<peso>), ...
+ * @endverbatim
+ *
+ * @param user      Ponteiro para o User.
+ * @param k         Quantidade máxima de leitores (> 0).
+ * @param withBooks !=0 para somar os livros lidos em comum ao peso.
+ */
+void PrintNearestUsers(User *user, int k, int withBooks);
+
+/**
+ * @brief Imprime os @p k livros mais lidos pelas afinidades de um leitor.
+ *
+ * Cada livro terminado por um vizinho em afinidades soma um ponto; livros
+ * que o leitor já leu ou deseja ficam de fora. As pontuações vão para um
+ * acumulador esparso e os K melhores saem de um min-heap limitado (ver
+ * topk.h), então o custo é proporcional ao volume de leitura dos
+ * vizinhos, e não ao tamanho do catálogo. O grafo de afinidades já deve
+ * estar construído.
+ *
+ * Formato:
+ * @verbatim
+ * Sugestões para <nome>: <título> (<pontos>), ...
+ * @endverbatim
+ *
+ * @param user Ponteiro para o User.
+ * @param k    Quantidade máxima de sugestões (> 0).
+ */
+void PrintSuggestionsUser(User *user, int k);
+
+/**
+ * @brief Imprime o menor caminho de afinidades entre dois leitores.
+ *
+ * Faz uma busca em largura bidirecional (um nível por vez, sempre do lado
+ * com a menor fronteira) sobre afinidades, com filas e vetores de pais
+ * reservados uma única vez para todos os leitores. Os leitores devem ter
+ * posição (SetIndexUser) e o grafo de afinidades já deve estar construído.
+ *
+ * Formato:
+ * @verbatim
+ * Caminho entre <nome1> e <nome2>: <nome1> -> ... -> <nome2>
+ * Não existe caminho entre <nome1> e <nome2>
+ * @endverbatim
+ *
+ * @param user1 Ponteiro para o User de origem.
+ * @param user2 Ponteiro para o User de destino.
+ */
+void PrintPathUsers(User *user1, User *user2);
+
+/**
+ * @brief Imprime os @p k leitores com livros lidos mais parecidos com os de @p user.
+ *
+ * A similaridade de Jaccard entre os conjuntos de livros lidos é estimada
+ * pelas assinaturas MinHash, mantidas a cada livro lido; os candidatos vêm
+ * do índice LSH (ver minhash.h), sem comparar @p user com todos os leitores.
+ * Leitores que não dividem nenhuma faixa da assinatura não aparecem.
+ *
+ * Formato:
+ * @verbatim
+ * Leitores parecidos com <nome>: <nome> (<similaridade>%), ...
+ * @endverbatim
+ *
+ * @param user Ponteiro para o User.
+ * @param k    Quantidade máxima de leitores (> 0).
+ */
+void PrintSimilarUsers(User *user, int k);
+
+/**
+ * @brief Imprime os leitores que terminaram um livro, na ordem em que o leram.
+ *
+ * Lê a lista do livro no índice reverso (ver bookindex.h), mantida a cada
+ * livro lido: o custo é proporcional aos leitores do livro, e não ao
+ * histórico de leitura de todos.
+ *
+ * Formato:
+ * @verbatim
+ * Leitores de "<título>": <nome>, ...
+ * @endverbatim
+ *
+ * @param book Handle do livro.
+ */
+void PrintReadersBookUsers(Book *book);
+
+/**
+ * @brief Imprime os leitores que desejam um livro (diretamente ou por
+ *        recomendação aceita), na ordem em que passaram a desejá-lo.
+ *
+ * Formato:
+ * @verbatim
+ * Interessados em "<título>": <nome>, ...
+ * @endverbatim
+ *
+ * @param book Handle do livro.
+ */
+void PrintWishersBookUsers(Book *book);
+
+/**
+ * @brief Imprime quantos livros lidos por @p user foram publicados de @p from a @p to.
+ *
+ * A contagem vem da árvore de Fenwick do leitor (ver CountFinishedYearIndex).
+ *
+ * Formato:
+ * @verbatim
+ * <nome> leu <n> livros publicados de <de> a <até>
+ * @endverbatim
+ *
+ * @param user Ponteiro para o User (do armazenamento, não uma cópia).
+ * @param from Primeiro ano (inclusive).
+ * @param to   Último ano (inclusive, >= @p from).
+ */
+void PrintYearCountUser(User *user, int from, int to);
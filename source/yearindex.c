@@ -0,0 +1,223 @@
+/**
+ * @file yearindex.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Implementation file for the publication-year index over the catalog and the readers' finished books.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <limits.h>
+#include "yearindex.h"
+#include "memory.h"
+
+typedef struct
+{
+    int count;     // livros indexados (o catálogo só cresce na carga)
+    int yearCount; // anos distintos
+    int *years;    // anos distintos, crescentes
+    int *first;    // livros do ano years[y] em order[first[y]..first[y + 1])
+    int *order;    // posições do catálogo por (ano, posição)
+    int **trees;   // árvore de Fenwick de cada leitor (1..yearCount), ou NULL
+    int treeCapacity;
+} YearIndex;
+
+static YearIndex calendar = {0};
+
+static int CompareYears(const void *ptr1, const void *ptr2)
+{
+    int index1 = *(const int *)ptr1;
+    int index2 = *(const int *)ptr2;
+    int year1 = GetYearBook(GetByIndexBook(index1));
+    int year2 = GetYearBook(GetByIndexBook(index2));
+
+    if (year1 != year2)
+        return (year1 > year2) - (year1 < year2);
+
+    return (index1 > index2) - (index1 < index2);
+}
+
+static void BuildYearIndex(void)
+{
+    FreeYearIndex();
+    int n = GetCountBooks();
+    calendar.count = n;
+    calendar.order = AllocMemory(MEMORY_INDEX, (n > 0 ? n : 1) * sizeof(int));
+    calendar.years = AllocMemory(MEMORY_INDEX, (n > 0 ? n : 1) * sizeof(int));
+    calendar.first = AllocMemory(MEMORY_INDEX, (n + 1) * sizeof(int));
+
+    for (int i = 0; i < n; i++)
+        calendar.order[i] = i;
+
+    qsort(calendar.order, n, sizeof(int), CompareYears);
+
+    for (int i = 0; i < n; i++)
+    {
+        int year = GetYearBook(GetByIndexBook(calendar.order[i]));
+
+        if (!calendar.yearCount || calendar.years[calendar.yearCount - 1] != year)
+        {
+            calendar.years[calendar.yearCount] = year;
+            calendar.first[calendar.yearCount++] = i;
+        }
+    }
+
+    calendar.first[calendar.yearCount] = n;
+}
+
+static void EnsureYearIndex(void)
+{
+    if (!calendar.order || calendar.count != GetCountBooks())
+        BuildYearIndex();
+}
+
+/**
+ * @brief Quantidade de anos distintos menores que @p year.
+ */
+static int LowerYear(int year)
+{
+    int low = 0;
+    int high = calendar.yearCount;
+
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+
+        if (calendar.years[middle] < year)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/**
+ * @brief Índices [low, high) dos anos distintos de @p from a @p to.
+ */
+static void RangeYears(int from, int to, int *low, int *high)
+{
+    *low = LowerYear(from);
+    *high = to == INT_MAX ? calendar.yearCount : LowerYear(to + 1);
+
+    if (*high < *low)
+        *high = *low;
+}
+
+void PrintRangeYearIndex(int from, int to, int limit)
+{
+    assert(from <= to);
+    assert(limit > 0);
+    EnsureYearIndex();
+
+    int low, high;
+    RangeYears(from, to, &low, &high);
+    int start = calendar.first[low];
+    int total = calendar.first[high] - start;
+
+    printf("Livros de %d a %d (%d): ", from, to, total);
+
+    for (int i = 0; i < total && i < limit; i++)
+    {
+        Book *book = GetByIndexBook(calendar.order[start + i]);
+        printf("%s%s (%d)", i ? ", " : "", GetTitleBook(book), GetYearBook(book));
+    }
+
+    if (!total)
+        printf("Nenhum livro");
+
+    printf("\n");
+}
+
+static void AddTree(int *tree, Book *book)
+{
+    // O ano está no catálogo indexado: a busca sempre o encontra.
+    for (int y = LowerYear(GetYearBook(book)) + 1; y <= calendar.yearCount; y += y & -y)
+        tree[y]++;
+}
+
+static int PrefixTree(int *tree, int y)
+{
+    int sum = 0;
+
+    for (; y > 0; y -= y & -y)
+        sum += tree[y];
+
+    return sum;
+}
+
+static void AddTreeBook(Book *book, void *context)
+{
+    AddTree(context, book);
+}
+
+int CountFinishedYearIndex(int position, BookSet *finished, int from, int to)
+{
+    assert(position >= 0);
+    assert(finished);
+    EnsureYearIndex();
+
+    if (position >= calendar.treeCapacity)
+    {
+        int capacity = calendar.treeCapacity ? calendar.treeCapacity : 64;
+
+        while (capacity <= position)
+            capacity *= 2;
+
+        calendar.trees = ReallocMemory(MEMORY_INDEX, calendar.trees, calendar.treeCapacity * sizeof(int *), capacity * sizeof(int *));
+        memset(calendar.trees + calendar.treeCapacity, 0, (capacity - calendar.treeCapacity) * sizeof(int *));
+        calendar.treeCapacity = capacity;
+    }
+
+    if (!calendar.trees[position])
+    {
+        calendar.trees[position] = CallocMemory(MEMORY_INDEX, calendar.yearCount + 1, sizeof(int));
+        ForEachBookSet(finished, AddTreeBook, calendar.trees[position]);
+    }
+
+    if (from > to)
+        return 0;
+
+    int low, high;
+    RangeYears(from, to, &low, &high);
+
+    return PrefixTree(calendar.trees[position], high) - PrefixTree(calendar.trees[position], low);
+}
+
+void AddYearIndex(int position, Book *book)
+{
+    assert(book);
+
+    // Árvores de um catálogo desatualizado serão descartadas na próxima consulta.
+    if (position >= calendar.treeCapacity || !calendar.trees[position] || calendar.count != GetCountBooks())
+        return;
+
+    AddTree(calendar.trees[position], book);
+}
+
+void FreeYearIndex(void)
+{
+    for (int i = 0; i < calendar.treeCapacity; i++)
+    {
+        if (calendar.trees[i])
+            FreeMemory(MEMORY_INDEX, calendar.trees[i], (calendar.yearCount + 1) * sizeof(int));
+    }
+
+    FreeMemory(MEMORY_INDEX, calendar.trees, calendar.treeCapacity * sizeof(int *));
+
+    if (calendar.order)
+    {
+        int n = calendar.count;
+        FreeMemory(MEMORY_INDEX, calendar.order, (n > 0 ? n : 1) * sizeof(int));
+        FreeMemory(MEMORY_INDEX, calendar.years, (n > 0 ? n : 1) * sizeof(int));
+        FreeMemory(MEMORY_INDEX, calendar.first, (n + 1) * sizeof(int));
+    }
+
+    memset(&calendar, 0, sizeof(calendar));
+}
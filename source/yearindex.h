@@ -0,0 +1,66 @@
+/**
+ * @file yearindex.h
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Header file for the publication-year index over the catalog and the readers' finished books.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "book.h"
+#include "bookset.h"
+
+/**
+ * @brief Imprime os livros do catálogo publicados de @p from a @p to.
+ *
+ * Na primeira chamada ordena as posições do catálogo por (ano, posição)
+ * e guarda os anos distintos com o início da faixa de cada um. Cada
+ * consulta são duas buscas binárias nos anos seguidas da cópia da faixa:
+ * O(log n + limit).
+ *
+ * Formato (por ano, depois pela ordem do catálogo):
+ * @verbatim
+ * Livros de <de> a <até> (<total>): <título> (<ano>), ...
+ * @endverbatim
+ *
+ * @param from  Primeiro ano (inclusive).
+ * @param to    Último ano (inclusive, >= @p from).
+ * @param limit Quantidade máxima de livros impressos (> 0).
+ */
+void PrintRangeYearIndex(int from, int to, int limit);
+
+/**
+ * @brief Conta os livros lidos por um leitor publicados de @p from a @p to.
+ *
+ * Cada leitor consultado ganha uma árvore de Fenwick sobre os anos
+ * distintos do catálogo, montada a partir de @p finished na primeira
+ * consulta e mantida por AddYearIndex depois: a contagem custa
+ * O(log n), qualquer que seja a quantidade de livros lidos.
+ *
+ * @param position Posição do leitor (GetIndexUser).
+ * @param finished Livros lidos pelo leitor.
+ * @param from     Primeiro ano (inclusive).
+ * @param to       Último ano (inclusive).
+ * @return Quantidade de livros lidos no intervalo.
+ */
+int CountFinishedYearIndex(int position, BookSet *finished, int from, int to);
+
+/**
+ * @brief Registra um livro lido na árvore do leitor, se ela já existir.
+ *
+ * Antes da primeira consulta do leitor não faz nada (nem decodifica o
+ * livro no modo preguiçoso): a árvore é montada do conjunto inteiro.
+ *
+ * @param position Posição do leitor.
+ * @param book     Livro recém-lido (ainda não registrado).
+ */
+void AddYearIndex(int position, Book *book);
+
+/**
+ * @brief Libera o índice de anos e as árvores dos leitores.
+ */
+void FreeYearIndex(void);
@@ -0,0 +1,68 @@
+/**
+ * @file journal_test.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Checks that a lone journal record is flushed once its group-commit window expires.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../../source/journal.h"
+
+#define JOURNAL_TEST_PATH "./journal_test.log"
+#define JOURNAL_TEST_WINDOW_MS 20
+
+/**
+ * @brief Lê o arquivo direto do descritor, sem passar pelo buffer do FILE do journal.
+ */
+static ssize_t ReadJournalFile(char *buffer, size_t size)
+{
+    int fd = open(JOURNAL_TEST_PATH, O_RDONLY);
+
+    if (fd < 0)
+        return -1;
+
+    ssize_t length = read(fd, buffer, size - 1);
+    close(fd);
+    buffer[length > 0 ? length : 0] = '\0';
+
+    return length;
+}
+
+int main(void)
+{
+    char buffer[256] = "";
+    unlink(JOURNAL_TEST_PATH);
+
+    // Grupo grande: só a janela pode disparar o fsync de um único registro.
+    Journal *journal = OpenJournal(JOURNAL_TEST_PATH, 64, JOURNAL_TEST_WINDOW_MS);
+    AppendJournal(journal, 1, 2, 3, 0);
+
+    if (ReadJournalFile(buffer, sizeof(buffer)) != 0)
+    {
+        printf("FALHOU: registro gravado antes da janela (\"%s\")\n", buffer);
+        return 1;
+    }
+
+    struct timespec wait = {0, 5 * JOURNAL_TEST_WINDOW_MS * 1000000L};
+    nanosleep(&wait, NULL);
+    ReadJournalFile(buffer, sizeof(buffer));
+    CloseJournal(journal);
+    unlink(JOURNAL_TEST_PATH);
+
+    if (strcmp(buffer, "1;2;3;0\n") != 0)
+    {
+        printf("FALHOU: registro não sincronizado após a janela (\"%s\")\n", buffer);
+        return 1;
+    }
+
+    printf("journal OK\n");
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/bin/bash
+
+# Uso: ./tests/matrix/matrix_check.sh
+# Gera uma carga sintética que termina com o comando 18 e compara o
+# arquivo de livros em comum das linhas densas com o do modo esparso
+# (BOOKED_MATRIX_DENSE_KB=0): têm que ser idênticos e não vazios.
+
+PROJ_NAME="booked"
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+gcc -O2 -Wall -o "$WORK/generator" "$ROOT/bench/generator.c" -lm || exit 1
+"$WORK/generator" -o "$WORK" -b 400 -r 300 -c 4000 -m 30,25,20,10,8,5,1,0 -s 11 > /dev/null || exit 1
+cd "$WORK" || exit 1
+printf '18;0;0;0;dense.csv\n' >> comandos.txt
+
+BOOKED_THREADS=4 "$ROOT/$PROJ_NAME" > /dev/null || { echo "matrix FALHOU: modo denso"; exit 1; }
+mv dense.csv expected.csv
+BOOKED_THREADS=4 BOOKED_MATRIX_DENSE_KB=0 "$ROOT/$PROJ_NAME" > /dev/null || { echo "matrix FALHOU: modo esparso"; exit 1; }
+
+[ "$(wc -l < expected.csv)" -gt 1 ] || { echo "matrix FALHOU: nenhum par gravado"; exit 1; }
+awk -F';' 'NR > 1 && $3 > 0 { found = 1 } END { exit !found }' expected.csv || { echo "matrix FALHOU: nenhum par com livros em comum"; exit 1; }
+diff -q expected.csv dense.csv > /dev/null || { echo "matrix FALHOU: modo esparso difere do denso"; exit 1; }
+
+echo "matrix OK"
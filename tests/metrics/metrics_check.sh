@@ -0,0 +1,67 @@
+#!/bin/bash
+
+# Uso: ./tests/metrics/metrics_check.sh [pasta de teste]
+# Roda o booked com BOOKED_METRICS numa pasta tests/testN e confere que o
+# relatório é bem formado: todas as fases, uma linha por operação com
+# percentis em ordem, chamadas batendo com o arquivo de comandos e o
+# total de memória. A saída padrão tem que continuar igual à esperada.
+
+PROJ_NAME="booked"
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+TEST=${1:-$ROOT/tests/test4}
+REPORT=$(mktemp)
+OUTPUT=$(mktemp)
+trap 'rm -f "$REPORT" "$OUTPUT"' EXIT
+
+cd "$TEST" || exit 1
+BOOKED_METRICS="$REPORT" "$ROOT/$PROJ_NAME" > "$OUTPUT" || { echo "metrics FALHOU: booked terminou com erro"; exit 1; }
+diff -q "$OUTPUT" saida.txt > /dev/null || { echo "metrics FALHOU: saída mudou com as métricas ligadas"; exit 1; }
+
+# Chamadas esperadas por operação, tiradas de comandos.txt (a primeira linha é o cabeçalho).
+EXPECTED=$(awk -F';' 'NR > 1 && $1 != "" { calls[$1]++ } END { for (op in calls) printf "%s=%d ", op, calls[op] }' comandos.txt)
+
+awk -v expected="$EXPECTED" '
+function fail(message) { print "metrics FALHOU: " message; failed = 1; exit 1 }
+
+BEGIN {
+    split("load_books build_search load_users build_graph replay_journal commands", phases, " ")
+    count = split(expected, pairs, " ")
+    for (i = 1; i <= count; i++) { split(pairs[i], pair, "="); want[pair[1]] = pair[2] }
+}
+
+/^phase / {
+    if ($2 != phases[++phase]) fail("fase " phase " deveria ser " phases[phase] ", veio " $2)
+    if ($3 != "seconds" || $4 !~ /^[0-9]+\.[0-9]+$/) fail("linha de fase malformada: " $0)
+    next
+}
+
+/^op / {
+    delete f
+    for (i = 3; i < NF; i += 2) f[$i] = $(i + 1)
+    if (!f["calls"] || f["errors"] > f["calls"]) fail("contagens inválidas: " $0)
+    if (f["calls"] != want[$2]) fail("op " $2 " com " f["calls"] " chamadas, esperadas " want[$2])
+    if (!(f["p50_ns"] <= f["p90_ns"] && f["p90_ns"] <= f["p99_ns"] && f["p99_ns"] <= f["p99.9_ns"] && f["p99.9_ns"] <= f["max_ns"]))
+        fail("percentis fora de ordem: " $0)
+    if (f["mean_ns"] > f["max_ns"]) fail("média acima do máximo: " $0)
+    seen[$2] = 1
+    next
+}
+
+/^unknown_ops / { unknown = $2; next }
+/^memory total / { total = 1; next }
+/^memory / || /^pager / { next }
+{ fail("linha inesperada: " $0) }
+
+END {
+    if (failed) exit 1
+    if (phase != 6) fail("esperadas 6 fases, vieram " phase)
+    for (op in want)
+    {
+        if (op + 0 < 1 || op + 0 == 9 || op + 0 > 23) wantUnknown += want[op]
+        else if (!seen[op]) fail("op " op " ausente do relatório")
+    }
+    if (unknown + 0 != wantUnknown) fail("unknown_ops " unknown + 0 ", esperados " wantUnknown)
+    if (!total) fail("sem a linha memory total")
+    print "metrics OK"
+}' "$REPORT"
@@ -0,0 +1,93 @@
+/**
+ * @file snapshot_test.c
+ * @author Paulo Sergio Amorim, Vitor S. Passamani (@paulosergioamorim, vitor.spassamani@gmail.com)
+ * @brief Checks that a dump prints the users as they were when its snapshot was taken.
+ * @version 0.1
+ * @date 2025-07-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include "../../source/book.h"
+#include "../../source/user.h"
+#include "../../source/list.h"
+#include "../../source/cell.h"
+#include "../../source/memory.h"
+#include "../../source/recommendation.h"
+#include "../../source/snapshot.h"
+
+/**
+ * @brief Bytes vivos contabilizados em MEMORY_SNAPSHOT.
+ */
+static long LiveSnapshotBytes(void)
+{
+    MemoryStats stats;
+    GetStatsMemory(MEMORY_SNAPSHOT, &stats);
+
+    return stats.liveBytes;
+}
+
+static void PrintAll(List *userList)
+{
+    Snapshot *snapshot = TakeSnapshot(userList);
+    PrintSnapshot(snapshot);
+    ReleaseSnapshot(snapshot);
+}
+
+int main(void)
+{
+    InitArenasMemory();
+    List *userList = CreateList(PrintUser, CompareIdUser);
+
+    Book *dune = CreateBook(1, "Duna", "Frank Herbert", "Ficção", 1965);
+    Book *emma = CreateBook(2, "Emma", "Jane Austen", "Romance", 1815);
+
+    char *anaGenres[] = {"Ficção"};
+    char *biaGenres[] = {"Romance"};
+    User *ana = CreateUser(1, "Ana", 1, anaGenres);
+    User *bia = CreateUser(2, "Bia", 1, biaGenres);
+    SetIndexUser(ana, 0);
+    SetIndexUser(bia, 1);
+    AppendList(userList, ana);
+    AppendList(userList, bia);
+
+    InsertFinishedBookUser(ana, dune);
+    InsertRecommendationUser(bia, emma, ana);
+
+    // Mutações depois do snapshot e antes do dump: o dump deve ignorá-las.
+    Snapshot *snapshot = TakeSnapshot(userList);
+    long before = LiveSnapshotBytes();
+
+    if (TakeRecommendationUser(bia, GetIdBook(dune), ana) || LiveSnapshotBytes() != before)
+    {
+        printf("FALHOU: recusa de recomendação inexistente copiou o leitor\n");
+        return 1;
+    }
+
+    InsertFinishedBookUser(bia, emma);
+    InsertWishedBookUser(bia, dune);
+    AcceptRecommendationUser(ana, GetIdBook(emma), bia);
+
+    printf("Snapshot anterior às mutações:\n\n");
+    PrintSnapshot(snapshot);
+    ReleaseSnapshot(snapshot);
+
+    if (LiveSnapshotBytes() != 0)
+    {
+        printf("FALHOU: %ld bytes de snapshot vivos após a liberação\n", LiveSnapshotBytes());
+        return 1;
+    }
+
+    printf("Estado atual:\n\n");
+    PrintAll(userList);
+
+    FreeStoreUsers();
+    FreeCatalogBooks();
+    FreeRecommendationPool();
+    FreeCellPools();
+    FreeArenasMemory();
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+#!/bin/bash
+
+# Uso: ./tests/store/store_check.sh
+# Roda o booked com os conjuntos de livros no arquivo de páginas
+# (BOOKED_USER_STORE) e o buffer pool no mínimo (PAGER_MIN_FRAMES):
+#   1. cada tests/testN tem que dar a saída esperada;
+#   2. numa carga sintética grande o bastante para despejar e regravar
+#      páginas, a saída tem que ser a mesma dos conjuntos em memória;
+#   3. com o arquivo limitado por ulimit, as gravações falham e os
+#      comandos afetados viram erro, sem derrubar o processo.
+
+PROJ_NAME="booked"
+FRAMES=4
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+for t in "$ROOT"/tests/test*/; do
+    (cd "$t" && BOOKED_USER_STORE="$WORK/store" BOOKED_USER_STORE_FRAMES=$FRAMES "$ROOT/$PROJ_NAME" | diff -q - saida.txt > /dev/null) ||
+        { echo "store FALHOU: $t"; exit 1; }
+done
+
+gcc -O2 -Wall -o "$WORK/generator" "$ROOT/bench/generator.c" -lm || exit 1
+mkdir -p "$WORK/data"
+"$WORK/generator" -o "$WORK/data" -b 400 -r 300 -c 4000 -m 30,25,20,10,8,5,1,0 -s 7 > /dev/null || exit 1
+cd "$WORK/data" || exit 1
+
+"$ROOT/$PROJ_NAME" > memory.txt || { echo "store FALHOU: carga sintética em memória"; exit 1; }
+BOOKED_USER_STORE="$WORK/store" BOOKED_USER_STORE_FRAMES=$FRAMES BOOKED_METRICS=metrics.txt "$ROOT/$PROJ_NAME" > store.txt ||
+    { echo "store FALHOU: carga sintética em arquivo"; exit 1; }
+diff -q memory.txt store.txt > /dev/null || { echo "store FALHOU: saída em arquivo difere da em memória"; exit 1; }
+awk '/^pager/ { found = 1; if ($7 <= 0 || $9 <= 0) exit 1 } END { exit !found }' metrics.txt ||
+    { echo "store FALHOU: nenhuma página despejada e regravada: $(grep ^pager metrics.txt)"; exit 1; }
+
+# Só a primeira página cabe no arquivo: gravar qualquer outra falha com EFBIG.
+# A saída passa por um pipe, que o limite não alcança.
+(trap '' XFSZ; ulimit -f 4; BOOKED_USER_STORE="$WORK/store" BOOKED_USER_STORE_FRAMES=$FRAMES exec "$ROOT/$PROJ_NAME") 2>&1 | cat > failed.txt
+status=${PIPESTATUS[0]}
+[ $status -eq 0 ] || { echo "store FALHOU: booked terminou com $status sem espaço no arquivo"; exit 1; }
+grep -q "^Erro: Falha de leitura ou gravação" failed.txt || { echo "store FALHOU: falha de gravação não foi informada"; exit 1; }
+
+echo "store OK"
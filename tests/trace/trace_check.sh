@@ -0,0 +1,52 @@
+#!/bin/bash
+
+# Uso: ./tests/trace/trace_check.sh [pasta de teste]
+# Roda o booked com BOOKED_TRACE e várias threads numa pasta tests/testN e
+# confere que o arquivo é um trace do Chrome válido: JSON com traceEvents,
+# todo evento com pid e tid, eventos completos com ts e dur, um
+# thread_name para cada tid, as fases de carga e as tarefas do pool.
+
+PROJ_NAME="booked"
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+TEST=${1:-$ROOT/tests/test4}
+TRACE=$(mktemp)
+trap 'rm -f "$TRACE"' EXIT
+
+cd "$TEST" || exit 1
+BOOKED_TRACE="$TRACE" BOOKED_THREADS=4 "$ROOT/$PROJ_NAME" > /dev/null || { echo "trace FALHOU: booked terminou com erro"; exit 1; }
+
+python3 - "$TRACE" <<'EOF'
+import json, sys
+
+def fail(message):
+    print("trace FALHOU: " + message)
+    sys.exit(1)
+
+try:
+    events = json.load(open(sys.argv[1]))["traceEvents"]
+except (ValueError, KeyError) as error:
+    fail("JSON inválido: %s" % error)
+
+named = {event["tid"] for event in events if event.get("ph") == "M" and event.get("name") == "thread_name"}
+categories = set()
+
+for event in events:
+    if not isinstance(event.get("pid"), int) or not isinstance(event.get("tid"), int):
+        fail("evento sem pid/tid: %s" % event)
+
+    if event["ph"] == "X":
+        if not isinstance(event.get("ts"), (int, float)) or not isinstance(event.get("dur"), (int, float)) or event["dur"] < 0:
+            fail("evento completo sem ts/dur: %s" % event)
+
+        if event["cat"] != "phase" and event["tid"] not in named:
+            fail("tid %d sem thread_name" % event["tid"])
+
+        categories.add(event["cat"])
+
+for category in ("phase", "threadpool"):
+    if category not in categories:
+        fail("nenhum evento da categoria %s" % category)
+
+print("trace OK")
+EOF